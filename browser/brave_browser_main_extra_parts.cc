@@ -76,3 +76,9 @@ void BraveBrowserMainExtraParts::PreMainMessageLoopRun() {
   brave::BraveUptimeTracker::CreateInstance(g_browser_process->local_state());
 #endif  // !defined(OS_ANDROID)
 }
+
+void BraveBrowserMainExtraParts::PostMainMessageLoopRun() {
+#if !defined(OS_ANDROID)
+  brave::BraveUptimeTracker::Shutdown();
+#endif  // !defined(OS_ANDROID)
+}
@@ -5,12 +5,15 @@
 
 #include "brave/browser/brave_browser_process_impl.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/path_service.h"
 #include "base/task/post_task.h"
 #include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/browser/brave_startup_scheduler.h"
 #include "brave/browser/brave_stats/brave_stats_updater.h"
 #include "brave/browser/component_updater/brave_component_updater_configurator.h"
 #include "brave/browser/component_updater/brave_component_updater_delegate.h"
@@ -183,25 +186,88 @@ ProfileManager* BraveBrowserProcessImpl::profile_manager() {
 
 void BraveBrowserProcessImpl::StartBraveServices() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(!startup_scheduler_);
 
-  ad_block_service()->Start();
-  https_everywhere_service()->Start();
+  using Priority = brave::BraveStartupScheduler::Priority;
+  startup_scheduler_ = std::make_unique<brave::BraveStartupScheduler>();
+  // Unretained is safe because the scheduler is owned by |this|.
+  auto* self = base::Unretained(this);
 
+  // Shields have to be in place before the first page loads.
+  startup_scheduler_->AddTask(
+      "AdBlock", Priority::kBeforeFirstNavigation, {},
+      base::BindOnce(
+          [](BraveBrowserProcessImpl* self) {
+            self->ad_block_service()->Start();
+          },
+          self));
+  startup_scheduler_->AddTask(
+      "HTTPSEverywhere", Priority::kBeforeFirstNavigation, {},
+      base::BindOnce(
+          [](BraveBrowserProcessImpl* self) {
+            self->https_everywhere_service()->Start();
+          },
+          self));
+
+  // TrackingProtectionHelper reads the service from the IO thread for every
+  // request when storage tracking protection is enabled, so it has to exist
+  // before the first navigation rather than be created lazily there.
+  startup_scheduler_->AddTask(
+      "TrackingProtection", Priority::kBeforeFirstNavigation, {},
+      base::BindOnce(base::IgnoreResult(
+                         &BraveBrowserProcessImpl::tracking_protection_service),
+                     self));
+
+  // Local data files observers only get data once the local data files
+  // service starts, which has to happen after all of them are created. Their
+  // data has always arrived asynchronously, so none of them block startup.
+  std::vector<std::string> local_data_files_observers{"TrackingProtection"};
+  auto add_local_data_files_observer =
+      [this, &local_data_files_observers](const std::string& name,
+                                          base::OnceClosure task) {
+        startup_scheduler_->AddTask(name, Priority::kAfterStartup, {},
+                                    std::move(task));
+        local_data_files_observers.push_back(name);
+      };
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-  extension_whitelist_service();
+  add_local_data_files_observer(
+      "ExtensionWhitelist",
+      base::BindOnce(base::IgnoreResult(
+                         &BraveBrowserProcessImpl::extension_whitelist_service),
+                     self));
 #endif
-  tracking_protection_service();
 #if BUILDFLAG(ENABLE_GREASELION)
-  greaselion_download_service();
+  add_local_data_files_observer(
+      "Greaselion",
+      base::BindOnce(base::IgnoreResult(
+                         &BraveBrowserProcessImpl::greaselion_download_service),
+                     self));
 #endif
 #if BUILDFLAG(ENABLE_SPEEDREADER)
-  speedreader_rewriter_service();
+  add_local_data_files_observer(
+      "Speedreader",
+      base::BindOnce(
+          base::IgnoreResult(
+              &BraveBrowserProcessImpl::speedreader_rewriter_service),
+          self));
 #endif
 #if BUILDFLAG(BRAVE_ADS_ENABLED)
-  user_model_file_service();
+  add_local_data_files_observer(
+      "UserModelFiles",
+      base::BindOnce(
+          base::IgnoreResult(&BraveBrowserProcessImpl::user_model_file_service),
+          self));
 #endif
   // Now start the local data files service, which calls all observers.
-  local_data_files_service()->Start();
+  startup_scheduler_->AddTask(
+      "LocalDataFiles", Priority::kAfterStartup, local_data_files_observers,
+      base::BindOnce(
+          [](BraveBrowserProcessImpl* self) {
+            self->local_data_files_service()->Start();
+          },
+          self));
+
+  startup_scheduler_->Start();
 
 #if BUILDFLAG(ENABLE_BRAVE_SYNC)
   brave_sync::NetworkTimeHelper::GetInstance()
@@ -22,6 +22,7 @@
 namespace brave {
 class BraveReferralsService;
 class BraveP3AService;
+class BraveStartupScheduler;
 }  // namespace brave
 
 namespace brave_component_updater {
@@ -79,7 +80,12 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
   ProfileManager* profile_manager() override;
   NotificationPlatformBridge* notification_platform_bridge() override;
 
+  // Starts the services Shields need right away and schedules the rest to
+  // start once browser startup is complete.
   void StartBraveServices();
+  brave::BraveStartupScheduler* startup_scheduler() {
+    return startup_scheduler_.get();
+  }
   brave_shields::AdBlockService* ad_block_service();
   brave_shields::AdBlockCustomFiltersService* ad_block_custom_filters_service();
   brave_shields::AdBlockRegionalServiceManager*
@@ -171,6 +177,8 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
       user_model_file_service_;
 #endif
 
+  std::unique_ptr<brave::BraveStartupScheduler> startup_scheduler_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   DISALLOW_COPY_AND_ASSIGN(BraveBrowserProcessImpl);
@@ -0,0 +1,121 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_startup_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "chrome/browser/after_startup_task_utils.h"
+
+namespace brave {
+
+namespace {
+
+void PostAfterStartupTask(base::OnceClosure task) {
+  AfterStartupTaskUtils::PostTask(
+      FROM_HERE, base::SequencedTaskRunnerHandle::Get(), std::move(task));
+}
+
+}  // namespace
+
+BraveStartupScheduler::Task::Task() = default;
+BraveStartupScheduler::Task::Task(Task&&) = default;
+BraveStartupScheduler::Task& BraveStartupScheduler::Task::operator=(Task&&) =
+    default;
+BraveStartupScheduler::Task::~Task() = default;
+
+BraveStartupScheduler::BraveStartupScheduler()
+    : BraveStartupScheduler(base::BindRepeating(&PostAfterStartupTask)) {}
+
+BraveStartupScheduler::BraveStartupScheduler(
+    DeferredTaskPoster deferred_task_poster)
+    : deferred_task_poster_(std::move(deferred_task_poster)) {}
+
+BraveStartupScheduler::~BraveStartupScheduler() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void BraveStartupScheduler::AddTask(
+    const std::string& name,
+    Priority priority,
+    const std::vector<std::string>& dependencies,
+    base::OnceClosure task) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!started_);
+
+  Task entry;
+  entry.name = name;
+  entry.priority = priority;
+  entry.closure = std::move(task);
+  for (const auto& dependency : dependencies) {
+    auto it = std::find_if(
+        tasks_.begin(), tasks_.end(),
+        [&dependency](const Task& task) { return task.name == dependency; });
+    DCHECK(it != tasks_.end())
+        << name << " depends on unknown startup task " << dependency;
+    if (it != tasks_.end())
+      entry.dependencies.push_back(it - tasks_.begin());
+  }
+  tasks_.push_back(std::move(entry));
+}
+
+void BraveStartupScheduler::Start() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!started_);
+  started_ = true;
+
+  // Dependencies are always added before their dependents, so a single pass
+  // from the back promotes everything a critical task needs.
+  for (size_t i = tasks_.size(); i-- > 0;) {
+    if (tasks_[i].priority != Priority::kBeforeFirstNavigation)
+      continue;
+    for (size_t dependency : tasks_[i].dependencies)
+      tasks_[dependency].priority = Priority::kBeforeFirstNavigation;
+  }
+
+  // Insertion order is a valid dependency order for both groups. Deferred
+  // tasks are posted one by one so other work can run in between.
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    if (tasks_[i].priority == Priority::kBeforeFirstNavigation) {
+      RunTask(i);
+    } else {
+      deferred_task_poster_.Run(base::BindOnce(
+          &BraveStartupScheduler::RunTask, weak_factory_.GetWeakPtr(), i));
+    }
+  }
+}
+
+bool BraveStartupScheduler::HasRun(const std::string& name) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = std::find_if(
+      tasks_.begin(), tasks_.end(),
+      [&name](const Task& task) { return task.name == name; });
+  return it != tasks_.end() && it->has_run;
+}
+
+void BraveStartupScheduler::RunTask(size_t index) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Task& task = tasks_[index];
+  DCHECK(!task.has_run);
+  for (size_t dependency : task.dependencies)
+    DCHECK(tasks_[dependency].has_run) << task.name;
+
+  TRACE_EVENT1("browser", "BraveStartupScheduler::RunTask", "name",
+               task.name);
+  const base::TimeTicks start = base::TimeTicks::Now();
+  std::move(task.closure).Run();
+  task.has_run = true;
+  base::UmaHistogramTimes("Brave.Startup.ServiceStartTime." + task.name,
+                          base::TimeTicks::Now() - start);
+}
+
+}  // namespace brave
@@ -0,0 +1,87 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_BRAVE_STARTUP_SCHEDULER_H_
+#define BRAVE_BROWSER_BRAVE_STARTUP_SCHEDULER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+
+namespace brave {
+
+// Starts Brave's browser-wide services at browser startup. Services needed
+// before the first navigation start right away; the rest wait until startup
+// is complete, so they don't compete with the first paint. Each task records
+// a trace event and a "Brave.Startup.ServiceStartTime.<name>" histogram. Both
+// only cover the task itself, i.e. creating or starting a service, and not
+// any loading it kicks off asynchronously, such as reading its data files.
+class BraveStartupScheduler {
+ public:
+  enum class Priority {
+    // Must be started before the first navigation.
+    kBeforeFirstNavigation,
+    // Can wait until after startup.
+    kAfterStartup,
+  };
+
+  // Posts |task| to run once browser startup is complete. Tasks posted in
+  // order must run in that order.
+  using DeferredTaskPoster = base::RepeatingCallback<void(base::OnceClosure)>;
+
+  BraveStartupScheduler();
+  // For tests, to control when deferred tasks run.
+  explicit BraveStartupScheduler(DeferredTaskPoster deferred_task_poster);
+  ~BraveStartupScheduler();
+
+  // Adds a task named |name|. It runs after all of |dependencies|, which must
+  // have been added before. A dependency of a task needed before the first
+  // navigation is needed before it as well, whatever its own priority.
+  void AddTask(const std::string& name,
+               Priority priority,
+               const std::vector<std::string>& dependencies,
+               base::OnceClosure task);
+
+  // Runs the tasks needed before the first navigation and schedules the rest.
+  // Must be called once, after all tasks are added.
+  void Start();
+
+  bool HasRun(const std::string& name) const;
+
+ private:
+  struct Task {
+    Task();
+    Task(Task&&);
+    Task& operator=(Task&&);
+    ~Task();
+
+    std::string name;
+    Priority priority = Priority::kAfterStartup;
+    // Indices into |tasks_|.
+    std::vector<size_t> dependencies;
+    base::OnceClosure closure;
+    bool has_run = false;
+  };
+
+  void RunTask(size_t index);
+
+  DeferredTaskPoster deferred_task_poster_;
+  std::vector<Task> tasks_;
+  bool started_ = false;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<BraveStartupScheduler> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(BraveStartupScheduler);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_BRAVE_STARTUP_SCHEDULER_H_
@@ -0,0 +1,44 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "base/logging.h"
+#include "base/process/process.h"
+#include "base/run_loop.h"
+#include "base/time/time.h"
+#include "brave/browser/brave_browser_process_impl.h"
+#include "brave/browser/brave_startup_scheduler.h"
+#include "chrome/browser/after_startup_task_utils.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+
+using BraveStartupSchedulerBrowserTest = InProcessBrowserTest;
+
+IN_PROC_BROWSER_TEST_F(BraveStartupSchedulerBrowserTest,
+                       ShieldsStartBeforeFirstNavigation) {
+  content::WebContents* web_contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_TRUE(content::WaitForLoadStop(web_contents));
+  // Upper bound for the cold start, including the test harness setup.
+  const base::TimeDelta time_to_first_navigation =
+      base::Time::Now() - base::Process::Current().CreationTime();
+  LOG(INFO) << "Process start to first navigation: "
+            << time_to_first_navigation.InMilliseconds() << "ms";
+
+  brave::BraveStartupScheduler* scheduler =
+      g_brave_browser_process->startup_scheduler();
+  ASSERT_TRUE(scheduler);
+  EXPECT_TRUE(scheduler->HasRun("AdBlock"));
+  EXPECT_TRUE(scheduler->HasRun("HTTPSEverywhere"));
+  // Used from the IO thread by network requests.
+  EXPECT_TRUE(scheduler->HasRun("TrackingProtection"));
+
+  // The remaining services start once startup is complete.
+  AfterStartupTaskUtils::SetBrowserStartupIsCompleteForTesting();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(scheduler->HasRun("LocalDataFiles"));
+}
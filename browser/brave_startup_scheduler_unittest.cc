@@ -0,0 +1,106 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_startup_scheduler.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+using Priority = BraveStartupScheduler::Priority;
+
+class BraveStartupSchedulerTest : public testing::Test {
+ protected:
+  BraveStartupSchedulerTest()
+      : scheduler_(base::BindRepeating(&BraveStartupSchedulerTest::Defer,
+                                       base::Unretained(this))) {}
+
+  void Defer(base::OnceClosure task) {
+    deferred_tasks_.push_back(std::move(task));
+  }
+
+  // Simulates startup completing.
+  void RunDeferredTasks() {
+    std::vector<base::OnceClosure> tasks = std::move(deferred_tasks_);
+    for (auto& task : tasks)
+      std::move(task).Run();
+  }
+
+  void AddTask(const std::string& name,
+               Priority priority,
+               const std::vector<std::string>& dependencies) {
+    scheduler_.AddTask(
+        name, priority, dependencies,
+        base::BindOnce(
+            [](std::vector<std::string>* log, const std::string& name) {
+              log->push_back(name);
+            },
+            &log_, name));
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  std::vector<base::OnceClosure> deferred_tasks_;
+  std::vector<std::string> log_;
+  BraveStartupScheduler scheduler_;
+};
+
+TEST_F(BraveStartupSchedulerTest, DefersNonCriticalTasks) {
+  AddTask("a", Priority::kBeforeFirstNavigation, {});
+  AddTask("b", Priority::kAfterStartup, {});
+  AddTask("c", Priority::kBeforeFirstNavigation, {});
+  scheduler_.Start();
+
+  EXPECT_EQ((std::vector<std::string>{"a", "c"}), log_);
+  EXPECT_TRUE(scheduler_.HasRun("a"));
+  EXPECT_FALSE(scheduler_.HasRun("b"));
+
+  RunDeferredTasks();
+  EXPECT_EQ((std::vector<std::string>{"a", "c", "b"}), log_);
+  EXPECT_TRUE(scheduler_.HasRun("b"));
+}
+
+TEST_F(BraveStartupSchedulerTest, DeferredTasksRunAfterDependencies) {
+  AddTask("a", Priority::kAfterStartup, {});
+  AddTask("b", Priority::kAfterStartup, {});
+  AddTask("c", Priority::kAfterStartup, {"a", "b"});
+  scheduler_.Start();
+  EXPECT_TRUE(log_.empty());
+
+  RunDeferredTasks();
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "c"}), log_);
+}
+
+TEST_F(BraveStartupSchedulerTest, CriticalTasksPromoteDependencies) {
+  AddTask("a", Priority::kAfterStartup, {});
+  AddTask("b", Priority::kAfterStartup, {"a"});
+  AddTask("c", Priority::kBeforeFirstNavigation, {"b"});
+  AddTask("d", Priority::kAfterStartup, {});
+  scheduler_.Start();
+
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "c"}), log_);
+  RunDeferredTasks();
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "c", "d"}), log_);
+}
+
+TEST_F(BraveStartupSchedulerTest, RecordsPerServiceHistograms) {
+  base::HistogramTester histogram_tester;
+  AddTask("a", Priority::kBeforeFirstNavigation, {});
+  AddTask("b", Priority::kAfterStartup, {});
+  scheduler_.Start();
+
+  histogram_tester.ExpectTotalCount("Brave.Startup.ServiceStartTime.a", 1);
+  histogram_tester.ExpectTotalCount("Brave.Startup.ServiceStartTime.b", 0);
+  RunDeferredTasks();
+  histogram_tester.ExpectTotalCount("Brave.Startup.ServiceStartTime.b", 1);
+}
+
+}  // namespace brave
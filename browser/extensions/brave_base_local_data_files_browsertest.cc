@@ -11,6 +11,7 @@
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
+#include "chrome/browser/after_startup_task_utils.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
@@ -34,6 +35,9 @@ void BaseLocalDataFilesBrowserTest::SetUpOnMainThread() {
 
 void BaseLocalDataFilesBrowserTest::PreRunTestOnMainThread() {
   ExtensionBrowserTest::PreRunTestOnMainThread();
+  // The local data files service starts once browser startup is complete.
+  AfterStartupTaskUtils::SetBrowserStartupIsCompleteForTesting();
+  base::RunLoop().RunUntilIdle();
   ASSERT_TRUE(
       g_brave_browser_process->local_data_files_service()->IsInitialized());
 }
@@ -365,6 +365,31 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
 }
 
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       FeatureChangesOnlyReinstallWhenRulesChange) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  greaselion_service->SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, false);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+
+  // No test rule depends on ads, so the installed extensions are kept.
+  greaselion_service->SetFeatureEnabled(greaselion::ADS, true);
+  greaselion_service->SetFeatureEnabled(greaselion::ADS, false);
+  EXPECT_TRUE(greaselion_service->ready());
+  EXPECT_EQ(extension_ids, greaselion_service->GetExtensionIdsForTesting());
+
+  // One test rule requires auto-contribute.
+  greaselion_service->SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  EXPECT_EQ(extension_ids.size() + 1,
+            greaselion_service->GetExtensionIdsForTesting().size());
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
                       ScriptInjectionWithBrowserVersionConditionLowWild) {
   ASSERT_TRUE(InstallMockExtension());
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/feature_list.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
@@ -36,7 +37,7 @@ namespace {
 // Helper struct for crafting responses.
 struct WriteData {
   base::WeakPtr<network::mojom::URLLoaderClient> client;
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   std::unique_ptr<mojo::DataPipeProducer> producer;
 };
 
@@ -46,9 +47,9 @@ void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
   }
 
   network::URLLoaderCompletionStatus status(net::OK);
-  status.encoded_data_length = write_data->data.size();
-  status.encoded_body_length = write_data->data.size();
-  status.decoded_body_length = write_data->data.size();
+  status.encoded_data_length = write_data->data->size();
+  status.encoded_body_length = write_data->data->size();
+  status.decoded_body_length = write_data->data->size();
   write_data->client->OnComplete(status);
 }
 
@@ -355,7 +356,7 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
     }
 
     auto response = network::mojom::URLResponseHead::New();
-    std::string response_data;
+    scoped_refptr<base::RefCountedString> response_data;
     brave_shields::MakeStubResponse(ctx_->mock_data_url, request_, &response,
                                     &response_data);
 
@@ -375,11 +376,11 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
 
     auto write_data = std::make_unique<WriteData>();
     write_data->client = weak_factory_.GetWeakPtr();
-    write_data->data = response_data;
+    write_data->data = std::move(response_data);
     write_data->producer =
         std::make_unique<mojo::DataPipeProducer>(std::move(producer));
 
-    base::StringPiece string_piece(write_data->data);
+    base::StringPiece string_piece(write_data->data->data());
     write_data->producer->Write(
         std::make_unique<mojo::StringDataSource>(
             string_piece, mojo::StringDataSource::AsyncWritingMode::
@@ -0,0 +1,351 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/strings/string_split.h"
+#include "base/test/thread_test_helper.h"
+#include "base/time/time.h"
+#include "brave/browser/brave_browser_process_impl.h"
+#include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
+#include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
+#include "brave/browser/net/brave_httpse_network_delegate_helper.h"
+#include "brave/browser/net/brave_request_handler.h"
+#include "brave/browser/net/brave_site_hacks_network_delegate_helper.h"
+#include "brave/browser/net/url_context.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "chrome/browser/extensions/extension_browsertest.h"
+#include "content/public/test/browser_test.h"
+#include "net/base/net_errors.h"
+#include "net/dns/mock_host_resolver.h"
+
+// Replays a fixed corpus of recorded page requests through the Shields
+// OnBeforeURLRequest chain, with local fixture ad-block rules and HTTPSE data.
+// Nothing leaves the machine: the host resolver is mocked and the requests
+// have no renderer, so no CNAME lookups are made.
+
+using extensions::ExtensionBrowserTest;
+
+namespace {
+
+const char kTestDataDirectory[] = "shields-replay-data";
+
+const char kHTTPSEverywhereComponentTestId[] =
+    "bhlmpjhncoojbkemjkeppfahkglffilp";
+
+const char kHTTPSEverywhereComponentTestBase64PublicKey[] =
+    "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEA3tAm7HooTNVGQ9cm7Yuc"
+    "M9sLM/V38JOXzdj7z9dyDIfO64N69Gr5dn3XRzLuD+Pyzpl8MzfY/tIbWNSw3I2a"
+    "8YcEPmyHl2L4HByKTm+eJ02ArhtkgtZKjiTDc84KQcsTBHqINkMUQYeUN3VW1lz2"
+    "yuZJrGlqlKCmQq7iRjCSUFu/C9mbJghTF8aKqmLbuf/pUXLpXFCRhCfaeabPqZP4"
+    "e9efRk7lsOraJMhF1Gcx0iubObKxl6Ov19e4nreYpw7Vp0fHodLzh0YxssLgNhTb"
+    "txtjWrJaXB5wghi1G0coTy6TgTXxoU9OU70eyf6PgdW4ZcaBIyM3tY6tme4zukvv"
+    "3wIDAQAB";
+
+struct ReplayRequest {
+  std::string expected_outcome;
+  blink::mojom::ResourceType resource_type;
+  GURL tab_url;
+  GURL request_url;
+};
+
+bool ParseResourceType(const std::string& name,
+                       blink::mojom::ResourceType* resource_type) {
+  static const struct {
+    const char* name;
+    blink::mojom::ResourceType type;
+  } kResourceTypes[] = {
+      {"main_frame", blink::mojom::ResourceType::kMainFrame},
+      {"sub_frame", blink::mojom::ResourceType::kSubFrame},
+      {"stylesheet", blink::mojom::ResourceType::kStylesheet},
+      {"script", blink::mojom::ResourceType::kScript},
+      {"image", blink::mojom::ResourceType::kImage},
+      {"font", blink::mojom::ResourceType::kFontResource},
+      {"xhr", blink::mojom::ResourceType::kXhr},
+      {"media", blink::mojom::ResourceType::kMedia},
+      {"ping", blink::mojom::ResourceType::kPing},
+  };
+  for (const auto& entry : kResourceTypes) {
+    if (name == entry.name) {
+      *resource_type = entry.type;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the |p|th percentile of |sorted_samples|, which must not be empty.
+base::TimeDelta GetPercentile(
+    const std::vector<base::TimeDelta>& sorted_samples,
+    size_t p) {
+  return sorted_samples[std::min(sorted_samples.size() - 1,
+                                 sorted_samples.size() * p / 100)];
+}
+
+// Formats the 50th, 90th and 99th percentiles and the maximum.
+std::string FormatPercentiles(std::vector<base::TimeDelta> samples) {
+  if (samples.empty())
+    return "no samples";
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&samples](size_t p) {
+    return std::to_string(GetPercentile(samples, p).InMicroseconds());
+  };
+  return "p50=" + percentile(50) + "us p90=" + percentile(90) +
+         "us p99=" + percentile(99) +
+         "us max=" + std::to_string(samples.back().InMicroseconds()) + "us";
+}
+
+// Upper bound for the 99th percentile of a whole OnBeforeURLRequest chain.
+// It is loose enough for debug and sanitizer builds, and only meant to catch
+// a stage that suddenly does blocking or per-request linear work.
+constexpr base::TimeDelta kHandlerP99Budget =
+    base::TimeDelta::FromMilliseconds(20);
+
+}  // namespace
+
+class BraveRequestHandlerReplayTest : public ExtensionBrowserTest {
+ public:
+  BraveRequestHandlerReplayTest() {}
+
+  void SetUp() override {
+    brave_shields::HTTPSEverywhereService::SetIgnorePortForTest(true);
+    brave_shields::HTTPSEverywhereService::
+        SetComponentIdAndBase64PublicKeyForTest(
+            kHTTPSEverywhereComponentTestId,
+            kHTTPSEverywhereComponentTestBase64PublicKey);
+    ExtensionBrowserTest::SetUp();
+  }
+
+  void SetUpOnMainThread() override {
+    ExtensionBrowserTest::SetUpOnMainThread();
+    host_resolver()->AddRule("*", "127.0.0.1");
+  }
+
+  void PreRunTestOnMainThread() override {
+    ExtensionBrowserTest::PreRunTestOnMainThread();
+    brave::RegisterPathProvider();
+    ASSERT_TRUE(InstallHTTPSEverywhereExtension());
+    ASSERT_TRUE(LoadAdBlockRules());
+    ASSERT_TRUE(LoadCorpus());
+    request_handler_ = std::make_unique<BraveRequestHandler>();
+  }
+
+  void TearDownOnMainThread() override {
+    request_handler_.reset();
+    ExtensionBrowserTest::TearDownOnMainThread();
+  }
+
+ protected:
+  struct Stage {
+    const char* name;
+    brave::OnBeforeURLRequestCallback callback;
+  };
+
+  base::FilePath GetTestDataDir() {
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    return test_data_dir;
+  }
+
+  bool InstallHTTPSEverywhereExtension() {
+    const extensions::Extension* httpse_extension = InstallExtension(
+        GetTestDataDir().AppendASCII("https-everywhere-data"), 1);
+    if (!httpse_extension)
+      return false;
+    g_brave_browser_process->https_everywhere_service()->OnComponentReady(
+        httpse_extension->id(), httpse_extension->path(), "");
+    scoped_refptr<base::ThreadTestHelper> helper(new base::ThreadTestHelper(
+        g_brave_browser_process->https_everywhere_service()->GetTaskRunner()));
+    return helper->Run();
+  }
+
+  bool LoadAdBlockRules() {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    std::string rules;
+    if (!base::ReadFileToString(GetTestDataDir()
+                                    .AppendASCII(kTestDataDirectory)
+                                    .AppendASCII("rules.txt"),
+                                &rules)) {
+      return false;
+    }
+    g_brave_browser_process->ad_block_service()->ResetForTest(rules, "");
+    return true;
+  }
+
+  bool LoadCorpus() {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    std::string corpus;
+    if (!base::ReadFileToString(GetTestDataDir()
+                                    .AppendASCII(kTestDataDirectory)
+                                    .AppendASCII("requests.txt"),
+                                &corpus)) {
+      return false;
+    }
+    for (const auto& line :
+         base::SplitString(corpus, "\n", base::TRIM_WHITESPACE,
+                           base::SPLIT_WANT_NONEMPTY)) {
+      if (line[0] == '#')
+        continue;
+      std::vector<std::string> fields = base::SplitString(
+          line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+      ReplayRequest request;
+      if (fields.size() != 4 ||
+          !ParseResourceType(fields[1], &request.resource_type)) {
+        LOG(ERROR) << "Malformed replay corpus line: " << line;
+        return false;
+      }
+      request.expected_outcome = fields[0];
+      request.tab_url = GURL(fields[2]);
+      request.request_url = GURL(fields[3]);
+      corpus_.push_back(request);
+    }
+    return !corpus_.empty();
+  }
+
+  // The OnBeforeURLRequest stages, in the order BraveRequestHandler runs them.
+  std::vector<Stage> GetStages() {
+    return {
+        {"SiteHacks",
+         base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork)},
+        {"AdBlockTP",
+         base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork)},
+        {"HTTPSE",
+         base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork)},
+        {"CommonStaticRedirect",
+         base::BindRepeating(
+             brave::OnBeforeURLRequest_CommonStaticRedirectWork)},
+    };
+  }
+
+  std::shared_ptr<brave::BraveRequestInfo> MakeRequestInfo(
+      const ReplayRequest& request) {
+    auto ctx = std::make_shared<brave::BraveRequestInfo>(request.request_url);
+    ctx->method = "GET";
+    ctx->tab_url = request.tab_url;
+    ctx->tab_origin = request.tab_url.GetOrigin();
+    ctx->initiator_url = request.tab_url.GetOrigin();
+    ctx->resource_type = request.resource_type;
+    ctx->request_identifier = ++next_request_identifier_;
+    return ctx;
+  }
+
+  // Runs |stage| for |ctx| and waits for it to finish, including any work it
+  // posts to other sequences. Returns the stage result.
+  int RunStage(const Stage& stage,
+               std::shared_ptr<brave::BraveRequestInfo> ctx,
+               base::TimeDelta* elapsed) {
+    base::RunLoop run_loop;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    int rv = stage.callback.Run(run_loop.QuitClosure(), ctx);
+    if (rv == net::ERR_IO_PENDING) {
+      run_loop.Run();
+      rv = net::OK;
+    }
+    *elapsed = base::TimeTicks::Now() - start;
+    return rv;
+  }
+
+  // Runs the full BraveRequestHandler chain for |request| and returns its
+  // outcome.
+  std::string RunHandler(const ReplayRequest& request,
+                         base::TimeDelta* elapsed) {
+    std::shared_ptr<brave::BraveRequestInfo> ctx = MakeRequestInfo(request);
+    GURL new_url;
+    int result = net::OK;
+    base::RunLoop run_loop;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    int rv = request_handler_->OnBeforeURLRequest(
+        ctx,
+        base::BindOnce(
+            [](int* result, base::OnceClosure quit, int rv) {
+              *result = rv;
+              std::move(quit).Run();
+            },
+            &result, run_loop.QuitClosure()),
+        &new_url);
+    if (rv == net::ERR_IO_PENDING)
+      run_loop.Run();
+    else
+      result = rv;
+    *elapsed = base::TimeTicks::Now() - start;
+    request_handler_->OnURLRequestDestroyed(ctx);
+
+    if (result == net::ERR_BLOCKED_BY_CLIENT)
+      return "block";
+    if (result == net::OK && !new_url.is_empty() &&
+        new_url != request.request_url) {
+      return "redirect";
+    }
+    return result == net::OK ? "allow" : net::ErrorToShortString(result);
+  }
+
+  std::vector<ReplayRequest> corpus_;
+  std::unique_ptr<BraveRequestHandler> request_handler_;
+  uint64_t next_request_identifier_ = 0;
+};
+
+// Keeps the corpus honest: every request must get the outcome it was recorded
+// with, so the benchmark below measures the work that actually ships.
+IN_PROC_BROWSER_TEST_F(BraveRequestHandlerReplayTest, ReplayOutcomes) {
+  for (const auto& request : corpus_) {
+    base::TimeDelta elapsed;
+    EXPECT_EQ(request.expected_outcome, RunHandler(request, &elapsed))
+        << request.request_url;
+  }
+}
+
+// Reports per-stage and end-to-end latency percentiles over several passes of
+// the corpus, after a warm-up pass that fills the Shields caches, and checks
+// the end-to-end 99th percentile against |kHandlerP99Budget|. Timings are only
+// meaningful in a release build. To run it, add
+// --gtest_also_run_disabled_tests to:
+// npm run test -- brave_browser_tests --filter=*ReplayBenchmark
+IN_PROC_BROWSER_TEST_F(BraveRequestHandlerReplayTest,
+                       DISABLED_ReplayBenchmark) {
+  constexpr int kPasses = 20;
+  const std::vector<Stage> stages = GetStages();
+  std::vector<std::vector<base::TimeDelta>> stage_samples(stages.size());
+  std::vector<base::TimeDelta> handler_samples;
+
+  for (int pass = 0; pass <= kPasses; ++pass) {
+    const bool warm_up = pass == 0;
+    for (const auto& request : corpus_) {
+      std::shared_ptr<brave::BraveRequestInfo> ctx = MakeRequestInfo(request);
+      for (size_t i = 0; i < stages.size(); ++i) {
+        base::TimeDelta elapsed;
+        const int rv = RunStage(stages[i], ctx, &elapsed);
+        if (!warm_up)
+          stage_samples[i].push_back(elapsed);
+        if (rv != net::OK)
+          break;
+      }
+
+      base::TimeDelta elapsed;
+      RunHandler(request, &elapsed);
+      if (!warm_up)
+        handler_samples.push_back(elapsed);
+    }
+  }
+
+  LOG(INFO) << "Replayed " << corpus_.size() << " requests " << kPasses
+            << " times";
+  for (size_t i = 0; i < stages.size(); ++i) {
+    LOG(INFO) << stages[i].name << ": " << FormatPercentiles(stage_samples[i]);
+  }
+  LOG(INFO) << "BraveRequestHandler::OnBeforeURLRequest: "
+            << FormatPercentiles(handler_samples);
+
+  std::sort(handler_samples.begin(), handler_samples.end());
+  EXPECT_LE(GetPercentile(handler_samples, 99), kHandlerP99Budget);
+}
@@ -7,11 +7,16 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "base/lazy_instance.h"
+#include "base/containers/flat_set.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
+#include "base/optional.h"
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
@@ -23,64 +28,68 @@
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/common/loader/network_utils.h"
 #include "third_party/blink/public/common/loader/referrer_utils.h"
-#include "third_party/re2/src/re2/re2.h"
 
 namespace brave {
 
 namespace {
 
-const std::string& GetQueryStringTrackers() {
-  static const base::NoDestructor<std::string> trackers(base::JoinString(
-      std::vector<std::string>(
-          {// https://github.com/brave/brave-browser/issues/4239
-           "fbclid", "gclid", "msclkid", "mc_eid",
-           // https://github.com/brave/brave-browser/issues/9879
-           "dclid",
-           // https://github.com/brave/brave-browser/issues/13644
-           "oly_anon_id", "oly_enc_id",
-           // https://github.com/brave/brave-browser/issues/11579
-           "_openstat",
-           // https://github.com/brave/brave-browser/issues/11817
-           "vero_conv", "vero_id",
-           // https://github.com/brave/brave-browser/issues/13647
-           "wickedid",
-           // https://github.com/brave/brave-browser/issues/11578
-           "yclid",
-           // https://github.com/brave/brave-browser/issues/9019
-           "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"}),
-      "|"));
+const base::flat_set<std::string>& GetQueryStringTrackers() {
+  static const base::NoDestructor<base::flat_set<std::string>> trackers([] {
+    std::vector<std::string> trackers(
+        {// https://github.com/brave/brave-browser/issues/4239
+         "fbclid", "gclid", "msclkid", "mc_eid",
+         // https://github.com/brave/brave-browser/issues/9879
+         "dclid",
+         // https://github.com/brave/brave-browser/issues/13644
+         "oly_anon_id", "oly_enc_id",
+         // https://github.com/brave/brave-browser/issues/11579
+         "_openstat",
+         // https://github.com/brave/brave-browser/issues/11817
+         "vero_conv", "vero_id",
+         // https://github.com/brave/brave-browser/issues/13647
+         "wickedid",
+         // https://github.com/brave/brave-browser/issues/11578
+         "yclid",
+         // https://github.com/brave/brave-browser/issues/9019
+         "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"});
+    // Parameter names are matched case-insensitively.
+    for (auto& tracker : trackers)
+      tracker = base::ToLowerASCII(tracker);
+    return base::flat_set<std::string>(std::move(trackers));
+  }());
   return *trackers;
 }
 
-// From src/components/autofill/content/renderer/page_passwords_analyser.cc
-// and password_form_conversion_utils.cc:
-#define DECLARE_LAZY_MATCHER(NAME, PATTERN)                                   \
-  struct LabelPatternLazyInstanceTraits_##NAME                                \
-      : public base::internal::DestructorAtExitLazyInstanceTraits<re2::RE2> { \
-    static re2::RE2* New(void* instance) {                                    \
-      re2::RE2::Options options;                                              \
-      options.set_case_sensitive(false);                                      \
-      re2::RE2* matcher = new (instance) re2::RE2(PATTERN, options);          \
-      DCHECK(matcher->ok());                                                  \
-      return matcher;                                                         \
-    }                                                                         \
-  };                                                                          \
-  base::LazyInstance<re2::RE2, LabelPatternLazyInstanceTraits_##NAME> NAME =  \
-      LAZY_INSTANCE_INITIALIZER
-
-// e.g. "?fbclid=1234"
-DECLARE_LAZY_MATCHER(tracker_only_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+$");
-
-// e.g. "?fbclid=1234&foo=1"
-DECLARE_LAZY_MATCHER(tracker_first_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+&");
-
-// e.g. "?foo=1&fbclid=1234" or "?foo=1&fbclid=1234&bar=2"
-DECLARE_LAZY_MATCHER(tracker_appended_matcher,
-                     "&(" + GetQueryStringTrackers() + ")=[^&]+");
-
-#undef DECLARE_LAZY_MATCHER
+// Returns true if |param| is a "name=value" pair with a non-empty value whose
+// name is a known tracker.
+bool IsQueryStringTracker(base::StringPiece param) {
+  const size_t separator = param.find('=');
+  if (separator == base::StringPiece::npos || separator + 1 == param.size())
+    return false;
+
+  return base::Contains(GetQueryStringTrackers(),
+                        base::ToLowerASCII(param.substr(0, separator)));
+}
+
+// Removes tracking parameters from |query| in a single pass. Returns
+// base::nullopt if nothing was removed.
+base::Optional<std::string> StripQueryStringTrackers(base::StringPiece query) {
+  std::vector<base::StringPiece> kept_params;
+  bool removed = false;
+  for (const auto& param : base::SplitStringPiece(
+           query, "&", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL)) {
+    if (IsQueryStringTracker(param)) {
+      removed = true;
+      continue;
+    }
+    kept_params.push_back(param);
+  }
+
+  if (!removed)
+    return base::nullopt;
+
+  return base::JoinString(kept_params, "&");
+}
 
 void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
@@ -106,23 +115,19 @@ void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
     return;
   }
 
-  std::string new_query = ctx->request_url.query();
-  // Note: the ordering of these replacements is important.
-  const int replacement_count =
-      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher.Get(), "");
-
-  if (replacement_count > 0) {
-    url::Replacements<char> replacements;
-    if (new_query.empty()) {
-      replacements.ClearQuery();
-    } else {
-      replacements.SetQuery(new_query.c_str(),
-                            url::Component(0, new_query.size()));
-    }
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
+  const base::Optional<std::string> new_query =
+      StripQueryStringTrackers(ctx->request_url.query_piece());
+  if (!new_query)
+    return;
+
+  url::Replacements<char> replacements;
+  if (new_query->empty()) {
+    replacements.ClearQuery();
+  } else {
+    replacements.SetQuery(new_query->c_str(),
+                          url::Component(0, new_query->size()));
   }
+  ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
 }
 
 bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
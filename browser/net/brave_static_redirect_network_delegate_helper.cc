@@ -10,7 +10,9 @@
 #include <string>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_piece_forward.h"
+#include "brave/browser/net/url_pattern_host_index.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -92,6 +94,21 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
   static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
       kTranslateLanguagePattern);
 #endif
+
+  static const base::NoDestructor<URLPatternHostIndex> host_index(
+      std::vector<const URLPattern*>({
+          &geo_pattern, &safeBrowsing_pattern, &safebrowsingfilecheck_pattern,
+          &crlSet_pattern1, &crlSet_pattern2, &crlSet_pattern3,
+          &crlSet_pattern4, &crxDownload_pattern, &autofill_pattern,
+          &gvt1_pattern, &googleDl_pattern,
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+          &translate_pattern, &translate_language_pattern,
+#endif
+      }));
+  // Most requests are not for any of the hosts below.
+  if (!host_index->MightMatch(request_url))
+    return net::OK;
+
   if (geo_pattern.MatchesURL(request_url)) {
     *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
     return net::OK;
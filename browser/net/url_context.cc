@@ -16,6 +16,7 @@
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/web_contents.h"
 #include "net/base/isolation_info.h"
 
 #if BUILDFLAG(IPFS_ENABLED)
@@ -120,20 +121,30 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
 
   Profile* profile = Profile::FromBrowserContext(browser_context);
   auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(map, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
-  ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
+  // Reuse the settings already read for this tab's page where possible.
+  content::WebContents* web_contents =
+      content::WebContents::FromFrameTreeNodeId(frame_tree_node_id);
+  auto* shields_observer =
+      web_contents ? brave_shields::BraveShieldsWebContentsObserver::
+                         FromWebContents(web_contents)
+                   : nullptr;
+  const brave_shields::ShieldsSettingsSnapshot settings =
+      shields_observer
+          ? shields_observer->GetShieldsSettingsSnapshot(map, ctx->tab_origin)
+          : brave_shields::GetShieldsSettingsSnapshot(map, ctx->tab_origin);
+  ctx->allow_brave_shields = settings.brave_shields_enabled;
+  ctx->allow_ads =
+      settings.ad_control_type == brave_shields::ControlType::ALLOW;
+  ctx->allow_http_upgradable_resource = !settings.https_everywhere_enabled;
 
   // HACK: after we fix multiple creations of BraveRequestInfo we should
   // use only tab_origin. Since we recreate BraveRequestInfo during consequent
   // stages of navigation, |tab_origin| changes and so does |allow_referrers|
   // flag, which is not what we want for determining referrers.
-  ctx->allow_referrers = brave_shields::AllowReferrers(
-      map,
-      ctx->redirect_source.is_empty() ? ctx->tab_origin : ctx->redirect_source);
+  ctx->allow_referrers =
+      ctx->redirect_source.is_empty()
+          ? settings.allow_referrers
+          : brave_shields::AllowReferrers(map, ctx->redirect_source);
   ctx->upload_data = GetUploadData(request);
 
   ctx->browser_context = browser_context;
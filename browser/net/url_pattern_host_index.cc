@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_pattern_host_index.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+URLPatternHostIndex::URLPatternHostIndex(
+    const std::vector<const URLPattern*>& patterns) {
+  std::vector<std::string> hosts;
+  std::vector<std::string> subdomain_hosts;
+  for (const URLPattern* pattern : patterns) {
+    DCHECK(pattern);
+    if (pattern->match_all_urls() || pattern->host().empty()) {
+      match_all_hosts_ = true;
+      continue;
+    }
+
+    if (pattern->match_subdomains()) {
+      subdomain_hosts.push_back(pattern->host());
+    } else {
+      hosts.push_back(pattern->host());
+    }
+  }
+
+  hosts_ = base::flat_set<std::string>(std::move(hosts));
+  subdomain_hosts_ = base::flat_set<std::string>(std::move(subdomain_hosts));
+}
+
+URLPatternHostIndex::~URLPatternHostIndex() = default;
+
+bool URLPatternHostIndex::MightMatch(const GURL& url) const {
+  if (match_all_hosts_)
+    return true;
+
+  base::StringPiece host = url.host_piece();
+  // URLPattern ignores a trailing dot on the host.
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  if (base::Contains(hosts_, host))
+    return true;
+
+  if (subdomain_hosts_.empty())
+    return false;
+
+  // Walk "a.b.c", "b.c", "c" looking for a "*.host" pattern.
+  while (!host.empty()) {
+    if (base::Contains(subdomain_hosts_, host))
+      return true;
+
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  return false;
+}
+
+}  // namespace brave
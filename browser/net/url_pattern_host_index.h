@@ -0,0 +1,44 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
+#define BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+
+class GURL;
+class URLPattern;
+
+namespace brave {
+
+// Indexes the hosts of a fixed set of URLPatterns so that URLs which cannot
+// match any of them are rejected with a couple of set lookups instead of
+// running every pattern. A positive answer only means the URL might match;
+// callers still run the patterns themselves to keep their precedence rules.
+class URLPatternHostIndex {
+ public:
+  explicit URLPatternHostIndex(const std::vector<const URLPattern*>& patterns);
+  ~URLPatternHostIndex();
+
+  URLPatternHostIndex(const URLPatternHostIndex&) = delete;
+  URLPatternHostIndex& operator=(const URLPatternHostIndex&) = delete;
+
+  bool MightMatch(const GURL& url) const;
+
+ private:
+  // Hosts of patterns that only match the host itself.
+  base::flat_set<std::string> hosts_;
+  // Hosts of "*.host" patterns, which also match any subdomain.
+  base::flat_set<std::string> subdomain_hosts_;
+  // Set if any pattern matches all hosts, which disables the index.
+  bool match_all_hosts_ = false;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_URL_PATTERN_HOST_INDEX_H_
@@ -0,0 +1,84 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_pattern_host_index.h"
+
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/time/time.h"
+#include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
+#include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=URLPatternHostIndexTest.*
+
+namespace brave {
+
+TEST(URLPatternHostIndexTest, MatchesExactHosts) {
+  const URLPattern pattern(URLPattern::SCHEME_HTTPS,
+                           "https://dl.google.com/release2/*");
+  const URLPatternHostIndex index({&pattern});
+
+  EXPECT_TRUE(index.MightMatch(GURL("https://dl.google.com/other")));
+  EXPECT_TRUE(index.MightMatch(GURL("http://dl.google.com./")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://www.dl.google.com/")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://google.com/")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://brave.com/")));
+}
+
+TEST(URLPatternHostIndexTest, MatchesSubdomains) {
+  const URLPattern pattern(URLPattern::SCHEME_HTTPS, "https://*.gvt1.com/*");
+  const URLPatternHostIndex index({&pattern});
+
+  EXPECT_TRUE(index.MightMatch(GURL("https://gvt1.com/")));
+  EXPECT_TRUE(index.MightMatch(GURL("https://r1.gvt1.com/")));
+  EXPECT_TRUE(index.MightMatch(GURL("https://a.b.gvt1.com/")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://gvt1.com.evil.com/")));
+  EXPECT_FALSE(index.MightMatch(GURL("https://notgvt1.com/")));
+}
+
+TEST(URLPatternHostIndexTest, MatchesAllHosts) {
+  const URLPattern pattern(URLPattern::SCHEME_HTTPS, "https://*/*");
+  const URLPatternHostIndex index({&pattern});
+
+  EXPECT_TRUE(index.MightMatch(GURL("https://brave.com/")));
+}
+
+TEST(URLPatternHostIndexTest, DISABLED_StaticRedirectBenchmark) {
+  const std::vector<GURL> urls({
+      GURL("https://www.example.com/index.html"),
+      GURL("https://cdn.example.net/static/app.js?v=1"),
+      GURL("https://fonts.gstatic.com/s/roboto/v20/font.woff2"),
+      GURL("https://www.gstatic.com/autofill/manifest.json"),
+      GURL("https://dl.google.com/release2/chrome_component/crl-set-1.crx3"),
+      GURL("https://r1.gvt1.com/edgedl/release2/chrome_component/file.crx3"),
+      GURL("https://safebrowsing.googleapis.com/v4/threatListUpdates"),
+      GURL("https://clients4.google.com/chrome-sync"),
+      GURL("https://update.googleapis.com/service/update2/json"),
+      GURL("https://bugs.chromium.org/p/chromium/issues/entry?comment=a"),
+      GURL("https://images.example.org/photo.jpg"),
+      GURL("https://api.example.io/v1/items?page=2"),
+  });
+  const int kIterations = 10000;
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& url : urls) {
+      GURL new_url;
+      OnBeforeURLRequest_StaticRedirectWorkForGURL(url, &new_url);
+      OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(url, &new_url);
+    }
+  }
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  LOG(INFO) << kIterations * urls.size() << " URLs redirected in "
+      << elapsed.InMillisecondsF() << "ms";
+}
+
+}  // namespace brave
@@ -97,6 +97,17 @@ void BraveUptimeTracker::CreateInstance(PrefService* local_state) {
   g_brave_uptime_tracker_instance = new BraveUptimeTracker(local_state);
 }
 
+// static
+void BraveUptimeTracker::Shutdown() {
+  // The instance is never destroyed, so record the usage since the last
+  // update and write out anything still batched.
+  if (g_brave_uptime_tracker_instance) {
+    g_brave_uptime_tracker_instance->timer_.Stop();
+    g_brave_uptime_tracker_instance->RecordUsage();
+    g_brave_uptime_tracker_instance->state_.Flush();
+  }
+}
+
 void BraveUptimeTracker::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterListPref(kDailyUptimesListPrefName);
 }
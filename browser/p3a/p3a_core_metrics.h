@@ -35,6 +35,9 @@ class BraveUptimeTracker {
   ~BraveUptimeTracker();
 
   static void CreateInstance(PrefService* local_state);
+  // Saves the uptime recorded so far. Must be called before |local_state| is
+  // written out for the last time.
+  static void Shutdown();
 
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
 // Leave a gap between Chromium values and our values in the kHistogramValue
 // array so that we don't have to renumber when new content settings types are
 // added upstream.
@@ -48,3 +50,9 @@ int ContentSettingTypeToHistogramValue(ContentSettingsType content_setting,
   return ContentSettingTypeToHistogramValue_ChromiumImpl(content_setting,
                                                          num_values);
 }
+
+// static
+uint64_t RendererContentSettingRules::NextBraveRulesGeneration() {
+  static std::atomic<uint64_t> generation{0};
+  return ++generation;
+}
@@ -6,10 +6,15 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
-#define BRAVE_CONTENT_SETTINGS_H                  \
-  ContentSettingsForOneType autoplay_rules;       \
-  ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+// |brave_rules_generation| is unique to each newly created set of rules,
+// including every set delivered to a renderer, and is kept by copies. It lets
+// renderers tell when the rules they cached lookups for were replaced.
+#define BRAVE_CONTENT_SETTINGS_H                                \
+  ContentSettingsForOneType autoplay_rules;                     \
+  ContentSettingsForOneType fingerprinting_rules;               \
+  ContentSettingsForOneType brave_shields_rules;                \
+  uint64_t brave_rules_generation = NextBraveRulesGeneration(); \
+  static uint64_t NextBraveRulesGeneration();
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
@@ -7,6 +7,8 @@
 
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
@@ -22,6 +24,8 @@
 #include "third_party/blink/renderer/platform/network/network_utils.h"
 #include "third_party/blink/renderer/platform/supplementable.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+#include "third_party/skia/include/core/SkImage.h"
 
 namespace {
 
@@ -31,31 +35,62 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
+const double maxUInt64AsDouble = UINT64_MAX;
+
+}  // namespace
+
+namespace brave {
+
+AudioFarblingHelper::AudioFarblingHelper() = default;
+
+// static
+AudioFarblingHelper AudioFarblingHelper::Balanced(double fudge_factor) {
+  AudioFarblingHelper helper;
+  helper.mode_ = Mode::kBalanced;
+  helper.fudge_factor_ = fudge_factor;
+  return helper;
 }
 
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
+// static
+AudioFarblingHelper AudioFarblingHelper::Maximum(uint64_t seed) {
+  AudioFarblingHelper helper;
+  helper.mode_ = Mode::kMaximum;
+  helper.seed_ = seed;
+  helper.state_ = seed;
+  return helper;
 }
 
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
+void AudioFarblingHelper::FarbleAudioChannel(base::span<float> samples) const {
+  switch (mode_) {
+    case Mode::kOff:
+      break;
+    case Mode::kBalanced:
+      FarbleAudioSamplesBalanced(fudge_factor_, samples.data(), samples.size());
+      break;
+    case Mode::kMaximum:
+      FarbleAudioSamplesMaximum(seed_, samples.data(), samples.size());
+      break;
   }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
 }
 
-}  // namespace
-
-namespace brave {
+float AudioFarblingHelper::FarbleAudioSample(float value, size_t index) {
+  switch (mode_) {
+    case Mode::kOff:
+      return value;
+    case Mode::kBalanced:
+      return value * fudge_factor_;
+    case Mode::kMaximum:
+      if (index == 0) {
+        // start of loop, reset to initial seed which was passed in and is
+        // based on the domain key
+        state_ = seed_;
+      }
+      // get next value in PRNG sequence
+      return NextMaximumFarblingAudioSample(&state_);
+  }
+  NOTREACHED();
+  return value;
+}
 
 const char kBraveSessionToken[] = "brave_session_token";
 const char BraveSessionCache::kSupplementName[] = "BraveSessionCache";
@@ -120,6 +155,8 @@ BraveSessionCache::BraveSessionCache(ExecutionContext& context)
   farbling_enabled_ = true;
 }
 
+BraveSessionCache::~BraveSessionCache() = default;
+
 BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   BraveSessionCache* cache =
       Supplement<ExecutionContext>::From<BraveSessionCache>(context);
@@ -130,7 +167,7 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarblingHelper BraveSessionCache::GetAudioFarblingHelper(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -139,19 +176,26 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
       }
       case BraveFarblingLevel::BALANCED: {
         const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
-        const double maxUInt64AsDouble = UINT64_MAX;
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarblingHelper::Balanced(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarblingHelper::Maximum(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarblingHelper();
+}
+
+void BraveSessionCache::FarbleAudioChannel(
+    blink::WebContentSettingsClient* settings,
+    base::span<float> samples) {
+  if (samples.empty())
+    return;
+  GetAudioFarblingHelper(settings).FarbleAudioChannel(samples);
 }
 
 scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
@@ -180,6 +224,11 @@ BraveSessionCache::PerturbPixelsInternal(
     return nullptr;
   if (image_bitmap->IsNull())
     return image_bitmap;
+  // Reading back an unchanged canvas hands us the same immutable snapshot
+  // again, and its canvas key only depends on the contents, so reuse it.
+  const sk_sp<SkImage> sk_image =
+      image_bitmap->PaintImageForCurrentFrame().GetSkImage();
+  const uint32_t image_id = sk_image ? sk_image->uniqueID() : 0;
   // convert to an ImageDataBuffer to normalize the pixel data to RGBA, 4 bytes
   // per pixel
   std::unique_ptr<blink::ImageDataBuffer> data_buffer =
@@ -188,25 +237,34 @@ BraveSessionCache::PerturbPixelsInternal(
     return nullptr;
   }
   uint8_t* pixels = const_cast<uint8_t*>(data_buffer->Pixels());
-  // This needs to be type size_t because we pass it to base::StringPiece
-  // later for content hashing. This is safe because the maximum canvas
-  // dimensions are less than SIZE_T_MAX. (Width and height are each
-  // limited to 32,767 pixels.)
-  const size_t pixel_count = data_buffer->Width() * data_buffer->Height();
+  // This is safe because the maximum canvas dimensions are less than
+  // SIZE_T_MAX. (Width and height are each limited to 32,767 pixels.)
+  const size_t width = data_buffer->Width();
+  const size_t height = data_buffer->Height();
+  const size_t pixel_count = width * height;
   // choose which channel (R, G, or B) to perturb
   const uint8_t* first_byte = reinterpret_cast<const uint8_t*>(domain_key_);
   uint8_t channel = *first_byte % 3;
   // calculate initial seed to find first pixel to perturb, based on session
-  // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
-      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(
-      base::StringPiece(reinterpret_cast<const char*>(pixels), pixel_count * 4),
-      canvas_key, sizeof canvas_key));
+  // key, domain key, and canvas contents. The contents are digested per tile
+  // with a cheap hash, so the keyed hash only has to cover the digests.
+  uint8_t* canvas_key = last_canvas_key_;
+  if (!image_id || image_id != last_perturbed_image_id_) {
+    WTF::Vector<uint64_t> tile_digests(
+        static_cast<wtf_size_t>(GetCanvasTileCount(width, height)));
+    HashCanvasTiles(pixels, width, height, tile_digests.data());
+    crypto::HMAC h(crypto::HMAC::SHA256);
+    uint64_t session_plus_domain_key =
+        session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
+    CHECK(h.Init(
+        reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
+        sizeof session_plus_domain_key));
+    CHECK(h.Sign(
+        base::StringPiece(reinterpret_cast<const char*>(tile_digests.data()),
+                          tile_digests.size() * sizeof(uint64_t)),
+        canvas_key, sizeof(last_canvas_key_)));
+    last_perturbed_image_id_ = image_id;
+  }
   uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
   uint64_t pixel_index;
   // iterate through 32-byte canvas key and use each bit to determine how to
@@ -222,10 +280,8 @@ BraveSessionCache::PerturbPixelsInternal(
     }
   }
   // convert back to a StaticBitmapImage to return to the caller
-  scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap =
-      blink::UnacceleratedStaticBitmapImage::Create(
-          data_buffer->RetainedImage());
-  return perturbed_bitmap;
+  return blink::UnacceleratedStaticBitmapImage::Create(
+      data_buffer->RetainedImage());
 }
 
 WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
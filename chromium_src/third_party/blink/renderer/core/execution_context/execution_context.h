@@ -10,7 +10,8 @@
 
 #include <random>
 
-#include "base/callback.h"
+#include "base/containers/span.h"
+#include "base/memory/scoped_refptr.h"
 
 namespace blink {
 class StaticBitmapImage;
@@ -27,7 +28,33 @@ using blink::TraceTrait;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Applies audio farbling to channel data. Each copy keeps its own PRNG state,
+// so helpers can be used concurrently from different threads.
+class CORE_EXPORT AudioFarblingHelper {
+ public:
+  // No farbling.
+  AudioFarblingHelper();
+  static AudioFarblingHelper Balanced(double fudge_factor);
+  static AudioFarblingHelper Maximum(uint64_t seed);
+
+  bool IsEnabled() const { return mode_ != Mode::kOff; }
+
+  // Farbles a whole channel in place, starting at sample index 0.
+  void FarbleAudioChannel(base::span<float> samples) const;
+
+  // Farbles a single sample. Samples must be passed in order, starting at
+  // index 0. Meant for loops that do other per-sample work.
+  float FarbleAudioSample(float value, size_t index);
+
+ private:
+  enum class Mode { kOff, kBalanced, kMaximum };
+
+  Mode mode_ = Mode::kOff;
+  double fudge_factor_ = 1.0;
+  uint64_t seed_ = 0;
+  // Current PRNG value for |FarbleAudioSample|.
+  uint64_t state_ = 0;
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -39,12 +66,14 @@ class CORE_EXPORT BraveSessionCache final
   static const char kSupplementName[];
 
   explicit BraveSessionCache(ExecutionContext&);
-  virtual ~BraveSessionCache() = default;
+  virtual ~BraveSessionCache();
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
+  AudioFarblingHelper GetAudioFarblingHelper(
       blink::WebContentSettingsClient* settings);
+  void FarbleAudioChannel(blink::WebContentSettingsClient* settings,
+                          base::span<float> samples);
   scoped_refptr<blink::StaticBitmapImage> PerturbPixels(
       blink::WebContentSettingsClient* settings,
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
@@ -56,6 +85,11 @@ class CORE_EXPORT BraveSessionCache final
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  // Last canvas snapshot that was perturbed, identified by its SkImage id,
+  // and the key derived from its contents, so repeated reads of an unchanged
+  // canvas skip hashing it. Only the key is kept, not the pixels.
+  uint32_t last_perturbed_image_id_ = 0;
+  uint8_t last_canvas_key_[32] = {};
 
   scoped_refptr<blink::StaticBitmapImage> PerturbPixelsInternal(
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
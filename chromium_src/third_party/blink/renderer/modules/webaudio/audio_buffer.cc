@@ -3,7 +3,7 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#include "base/callback.h"
+#include "base/containers/span.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
 #include "third_party/blink/renderer/core/dom/document.h"
@@ -13,36 +13,25 @@
 #include "third_party/blink/renderer/core/workers/worker_global_scope.h"
 #include "third_party/blink/renderer/modules/webaudio/analyser_node.h"
 
-#define BRAVE_AUDIOBUFFER_GETCHANNELDATA                                       \
-  NotShared<DOMFloat32Array> array = getChannelData(channel_index);            \
-  if (ExecutionContext* context = ExecutionContext::From(script_state)) {      \
-    if (WebContentSettingsClient* settings =                                   \
-            brave::GetContentSettingsClientFor(context)) {                     \
-      DOMFloat32Array* destination_array = array.View();                       \
-      size_t len = destination_array->length();                                \
-      if (len > 0) {                                                           \
-        float* destination = destination_array->Data();                        \
-        brave::AudioFarblingCallback audio_farbling_callback =                 \
-            brave::BraveSessionCache::From(*context).GetAudioFarblingCallback( \
-                settings);                                                     \
-        for (unsigned i = 0; i < len; ++i) {                                   \
-          destination[i] = audio_farbling_callback.Run(destination[i], i);     \
-        }                                                                      \
-      }                                                                        \
-    }                                                                          \
+#define BRAVE_AUDIOBUFFER_GETCHANNELDATA                                  \
+  NotShared<DOMFloat32Array> array = getChannelData(channel_index);       \
+  if (ExecutionContext* context = ExecutionContext::From(script_state)) { \
+    if (WebContentSettingsClient* settings =                              \
+            brave::GetContentSettingsClientFor(context)) {                \
+      DOMFloat32Array* destination_array = array.View();                  \
+      brave::BraveSessionCache::From(*context).FarbleAudioChannel(        \
+          settings, base::make_span(destination_array->Data(),            \
+                                    destination_array->length()));        \
+    }                                                                     \
   }
 
-#define BRAVE_AUDIOBUFFER_COPYFROMCHANNEL                                    \
-  if (ExecutionContext* context = ExecutionContext::From(script_state)) {    \
-    if (WebContentSettingsClient* settings =                                 \
-            brave::GetContentSettingsClientFor(context)) {                   \
-      brave::AudioFarblingCallback audio_farbling_callback =                 \
-          brave::BraveSessionCache::From(*context).GetAudioFarblingCallback( \
-              settings);                                                     \
-      for (unsigned i = 0; i < count; i++) {                                 \
-        dst[i] = audio_farbling_callback.Run(dst[i], i);                     \
-      }                                                                      \
-    }                                                                        \
+#define BRAVE_AUDIOBUFFER_COPYFROMCHANNEL                                 \
+  if (ExecutionContext* context = ExecutionContext::From(script_state)) { \
+    if (WebContentSettingsClient* settings =                              \
+            brave::GetContentSettingsClientFor(context)) {                \
+      brave::BraveSessionCache::From(*context).FarbleAudioChannel(        \
+          settings, base::make_span(dst, count));                         \
+    }                                                                     \
   }
 
 #include "../../../../../../../third_party/blink/renderer/modules/webaudio/audio_buffer.cc"
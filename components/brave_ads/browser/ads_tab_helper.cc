@@ -8,6 +8,9 @@
 #include <memory>
 #include <utility>
 
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/third_party/icu/icu_utf.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -27,6 +30,74 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Maximum length of page text passed on for classification, in UTF-16 code
+// units as counted by JavaScript. The text classifier only needs a
+// representative sample of the page, so there is no point in extracting and
+// copying multi-megabyte documents
+const size_t kMaximumPageTextLength = 32 * 1024;
+
+// Collects text from the DOM without forcing layout, unlike
+// |document.body.innerText|, and stops once |maxLength| characters have been
+// gathered. Like |innerText| it leaves out hidden elements, keeps inline runs
+// together and puts block elements on their own lines, but it only looks at
+// the hidden attribute and inline styles so that no style is computed
+const char kExtractPageTextScript[] = R"(
+  (function(maxLength) {
+    if (!document.body) {
+      return '';
+    }
+
+    const kIgnoredElements = ['SCRIPT', 'STYLE', 'NOSCRIPT', 'TEMPLATE'];
+
+    const kBlockElements = ['ADDRESS', 'ARTICLE', 'ASIDE', 'BLOCKQUOTE', 'BR',
+        'DD', 'DIV', 'DL', 'DT', 'FIELDSET', 'FIGCAPTION', 'FIGURE', 'FOOTER',
+        'FORM', 'H1', 'H2', 'H3', 'H4', 'H5', 'H6', 'HEADER', 'HR', 'LI',
+        'MAIN', 'NAV', 'OL', 'P', 'PRE', 'SECTION', 'TABLE', 'TD', 'TH', 'TR',
+        'UL'];
+
+    const isHidden = function(element) {
+      if (element.hidden) {
+        return true;
+      }
+
+      const style = element.style;
+      return style && (style.display === 'none' ||
+          style.visibility === 'hidden');
+    };
+
+    const walker = document.createTreeWalker(document.body,
+        NodeFilter.SHOW_ELEMENT | NodeFilter.SHOW_TEXT, {
+      acceptNode: function(node) {
+        if (node.nodeType === Node.TEXT_NODE) {
+          return NodeFilter.FILTER_ACCEPT;
+        }
+
+        if (kIgnoredElements.includes(node.nodeName) || isHidden(node)) {
+          return NodeFilter.FILTER_REJECT;
+        }
+
+        return NodeFilter.FILTER_ACCEPT;
+      }
+    });
+
+    let text = '';
+    while (text.length < maxLength && walker.nextNode()) {
+      const node = walker.currentNode;
+      if (node.nodeType === Node.TEXT_NODE) {
+        text += node.nodeValue.replace(/\s+/g, ' ');
+      } else if (kBlockElements.includes(node.nodeName)) {
+        text += '\n';
+      }
+    }
+
+    text = text.replace(/ *\n\s*/g, '\n').replace(/ +/g, ' ').trim();
+    return text.substring(0, maxLength);
+  })(";
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -73,12 +144,41 @@ void AdsTabHelper::TabUpdated() {
       is_active_, is_browser_active_);
 }
 
+// static
+std::string AdsTabHelper::GetExtractPageTextScript(
+    const size_t max_length) {
+  return kExtractPageTextScript + base::NumberToString(max_length) + ")";
+}
+
+// static
+std::string AdsTabHelper::TruncatePageText(
+    const std::string& text,
+    const size_t max_length) {
+  // A UTF-8 string never has fewer bytes than UTF-16 code units
+  if (text.length() <= max_length) {
+    return text;
+  }
+
+  const base::string16 text16 = base::UTF8ToUTF16(text);
+  if (text16.length() <= max_length) {
+    return text;
+  }
+
+  size_t length = max_length;
+  if (length > 0 && CBU16_IS_LEAD(text16[length - 1])) {
+    length--;
+  }
+
+  return base::UTF16ToUTF8(text16.substr(0, length));
+}
+
 void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(render_frame_host,
-      "document.body.innerText",
+  const std::string script = GetExtractPageTextScript(kMaximumPageTextLength);
+
+  dom_distiller::RunIsolatedJavaScript(render_frame_host, script,
           base::BindOnce(&AdsTabHelper::OnJavaScriptResult,
               weak_factory_.GetWeakPtr()));
 }
@@ -87,9 +187,13 @@ void AdsTabHelper::OnJavaScriptResult(
     base::Value value) {
   DCHECK(ads_service_ && ads_service_->IsEnabled());
 
-  DCHECK(value.is_string());
-  std::string content;
-  value.GetAsString(&content);
+  if (!value.is_string()) {
+    return;
+  }
+
+  // Do not trust the renderer to have honored the limit
+  const std::string content =
+      TruncatePageText(value.GetString(), kMaximumPageTextLength);
 
   ads_service_->OnPageLoaded(tab_id_, redirect_chain_, content);
 }
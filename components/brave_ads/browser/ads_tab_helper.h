@@ -50,6 +50,17 @@ class AdsTabHelper : public content::WebContentsObserver,
   AdsTabHelper(const AdsTabHelper&) = delete;
   AdsTabHelper& operator=(const AdsTabHelper&) = delete;
 
+  // Returns the script which extracts up to |max_length| UTF-16 code units of
+  // text from the page
+  static std::string GetExtractPageTextScript(
+      const size_t max_length);
+
+  // Truncates UTF-8 |text| to at most |max_length| UTF-16 code units without
+  // splitting a surrogate pair
+  static std::string TruncatePageText(
+      const std::string& text,
+      const size_t max_length);
+
  private:
   friend class content::WebContentsUserData<AdsTabHelper>;
 
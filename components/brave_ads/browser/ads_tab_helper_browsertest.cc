@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/path_service.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_ads/browser/ads_tab_helper.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+
+// npm run test -- brave_browser_tests --filter=AdsTabHelper*
+
+namespace brave_ads {
+
+class AdsTabHelperBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    embedded_test_server()->ServeFilesFromDirectory(
+        test_data_dir.AppendASCII("ads"));
+    ASSERT_TRUE(embedded_test_server()->Start());
+  }
+
+  std::string ExtractPageText(const size_t max_length) {
+    content::WebContents* web_contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    return content::EvalJs(web_contents,
+        AdsTabHelper::GetExtractPageTextScript(max_length)).ExtractString();
+  }
+};
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, ExtractsVisiblePageText) {
+  ui_test_utils::NavigateToURL(browser(),
+      embedded_test_server()->GetURL("a.com", "/page_text.html"));
+
+  EXPECT_EQ("Buy cheap flights\nBooking made easy.\nOne\nTwo",
+      ExtractPageText(32 * 1024));
+}
+
+IN_PROC_BROWSER_TEST_F(AdsTabHelperBrowserTest, LimitsPageTextLength) {
+  ui_test_utils::NavigateToURL(browser(),
+      embedded_test_server()->GetURL("a.com", "/page_text.html"));
+
+  EXPECT_EQ("Buy cheap", ExtractPageText(9));
+}
+
+TEST(AdsTabHelperTest, TruncatesPageTextToUtf16Length) {
+  EXPECT_EQ("abc", AdsTabHelper::TruncatePageText("abc", 3));
+  EXPECT_EQ("ab", AdsTabHelper::TruncatePageText("abc", 2));
+
+  // Each character is two UTF-8 bytes but a single UTF-16 code unit
+  const std::string text = "\xC3\xA9\xC3\xA9\xC3\xA9";
+  EXPECT_EQ(text, AdsTabHelper::TruncatePageText(text, 3));
+
+  // A surrogate pair is never split
+  const std::string emoji = "a\xF0\x9F\x98\x80";
+  EXPECT_EQ("a", AdsTabHelper::TruncatePageText(emoji, 2));
+  EXPECT_EQ(emoji, AdsTabHelper::TruncatePageText(emoji, 3));
+}
+
+}  // namespace brave_ads
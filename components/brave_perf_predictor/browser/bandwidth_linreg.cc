@@ -9,14 +9,40 @@
 #include <cmath>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
 
 namespace {
 
+constexpr char kThirdPartyFeaturePrefix[] = "thirdParties.";
+constexpr char kThirdPartyFeatureSuffix[] = ".blocked";
+
+base::flat_map<std::string, unsigned int> BuildThirdPartyFeatureMap() {
+  std::vector<std::pair<std::string, unsigned int>> entries;
+  for (unsigned int i = standardise_feat_count; i < feature_count; i++) {
+    const std::string& name = feature_sequence[i];
+    if (!base::StartsWith(name, kThirdPartyFeaturePrefix,
+                          base::CompareCase::SENSITIVE) ||
+        !base::EndsWith(name, kThirdPartyFeatureSuffix,
+                        base::CompareCase::SENSITIVE)) {
+      continue;
+    }
+    const size_t prefix_length = sizeof(kThirdPartyFeaturePrefix) - 1;
+    const size_t suffix_length = sizeof(kThirdPartyFeatureSuffix) - 1;
+    entries.emplace_back(
+        name.substr(prefix_length,
+                    name.size() - prefix_length - suffix_length),
+        i);
+  }
+  return base::flat_map<std::string, unsigned int>(std::move(entries));
+}
+
 bool StandardiseFeatsNoOutliers(
     std::array<double, standardise_feat_count>* features,
     const std::array<double, standardise_feat_count>& means,
@@ -37,6 +63,16 @@ bool StandardiseFeatsNoOutliers(
 
 }  // namespace
 
+base::Optional<unsigned int> GetThirdPartyBlockedFeature(
+    const std::string& entity) {
+  static const base::NoDestructor<base::flat_map<std::string, unsigned int>>
+      third_party_features(BuildThirdPartyFeatureMap());
+  const auto it = third_party_features->find(entity);
+  if (it == third_party_features->end())
+    return base::nullopt;
+  return it->second;
+}
+
 double LinregPredictVector(const std::array<double, feature_count>& features) {
   // Standardise numeric features
   std::array<double, standardise_feat_count> numeric_features;
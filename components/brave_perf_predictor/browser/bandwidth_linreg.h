@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -18,6 +19,44 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+// Positions of the standardised numeric features in |feature_sequence|. The
+// per-entity "thirdParties.<entity>.blocked" features follow them, see
+// |GetThirdPartyBlockedFeature|.
+enum Feature : unsigned int {
+  kAdblockRequests = 0,
+  kFirstMeaningfulPaint,
+  kObservedDomContentLoaded,
+  kObservedFirstVisualChange,
+  kObservedLoad,
+  kDocumentRequestCount,
+  kDocumentSize,
+  kFontRequestCount,
+  kFontSize,
+  kImageRequestCount,
+  kImageSize,
+  kMediaRequestCount,
+  kMediaSize,
+  kOtherRequestCount,
+  kOtherSize,
+  kScriptRequestCount,
+  kScriptSize,
+  kStylesheetRequestCount,
+  kStylesheetSize,
+  kThirdPartyRequestCount,
+  kThirdPartySize,
+  kTotalRequestCount,
+  kTotalSize,
+  kNumericFeatureCount
+};
+
+static_assert(kNumericFeatureCount == standardise_feat_count,
+              "Feature enum is out of sync with the model parameters");
+
+// Returns the position of the "thirdParties.<entity>.blocked" feature, or
+// nullopt if the model does not use |entity|.
+base::Optional<unsigned int> GetThirdPartyBlockedFeature(
+    const std::string& entity);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
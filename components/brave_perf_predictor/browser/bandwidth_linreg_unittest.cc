@@ -43,6 +43,56 @@ TEST(BraveSavingsPredictorTest, HandlesSpecificVectorExample) {
             794);  // Equal on the order of thousands
 }
 
+TEST(BraveSavingsPredictorTest, FeatureIndicesMatchModel) {
+  EXPECT_EQ(feature_sequence[kAdblockRequests], "adblockRequests");
+  EXPECT_EQ(feature_sequence[kFirstMeaningfulPaint],
+            "metrics.firstMeaningfulPaint");
+  EXPECT_EQ(feature_sequence[kObservedDomContentLoaded],
+            "metrics.observedDomContentLoaded");
+  EXPECT_EQ(feature_sequence[kObservedFirstVisualChange],
+            "metrics.observedFirstVisualChange");
+  EXPECT_EQ(feature_sequence[kObservedLoad], "metrics.observedLoad");
+  EXPECT_EQ(feature_sequence[kDocumentRequestCount],
+            "resources.document.requestCount");
+  EXPECT_EQ(feature_sequence[kDocumentSize], "resources.document.size");
+  EXPECT_EQ(feature_sequence[kFontRequestCount], "resources.font.requestCount");
+  EXPECT_EQ(feature_sequence[kFontSize], "resources.font.size");
+  EXPECT_EQ(feature_sequence[kImageRequestCount],
+            "resources.image.requestCount");
+  EXPECT_EQ(feature_sequence[kImageSize], "resources.image.size");
+  EXPECT_EQ(feature_sequence[kMediaRequestCount],
+            "resources.media.requestCount");
+  EXPECT_EQ(feature_sequence[kMediaSize], "resources.media.size");
+  EXPECT_EQ(feature_sequence[kOtherRequestCount],
+            "resources.other.requestCount");
+  EXPECT_EQ(feature_sequence[kOtherSize], "resources.other.size");
+  EXPECT_EQ(feature_sequence[kScriptRequestCount],
+            "resources.script.requestCount");
+  EXPECT_EQ(feature_sequence[kScriptSize], "resources.script.size");
+  EXPECT_EQ(feature_sequence[kStylesheetRequestCount],
+            "resources.stylesheet.requestCount");
+  EXPECT_EQ(feature_sequence[kStylesheetSize], "resources.stylesheet.size");
+  EXPECT_EQ(feature_sequence[kThirdPartyRequestCount],
+            "resources.third-party.requestCount");
+  EXPECT_EQ(feature_sequence[kThirdPartySize], "resources.third-party.size");
+  EXPECT_EQ(feature_sequence[kTotalRequestCount],
+            "resources.total.requestCount");
+  EXPECT_EQ(feature_sequence[kTotalSize], "resources.total.size");
+}
+
+TEST(BraveSavingsPredictorTest, ThirdPartyBlockedFeature) {
+  for (unsigned int i = standardise_feat_count; i < feature_count; i++) {
+    const std::string& name = feature_sequence[i];
+    // Strip "thirdParties." and ".blocked"
+    const std::string entity = name.substr(13, name.size() - 13 - 8);
+    const auto feature = GetThirdPartyBlockedFeature(entity);
+    ASSERT_TRUE(feature.has_value()) << name;
+    EXPECT_EQ(feature.value(), i);
+  }
+
+  EXPECT_FALSE(GetThirdPartyBlockedFeature("Not A Known Entity").has_value());
+}
+
 TEST(BraveSavingsPredictorTest, HandlesEmptyFeatureset) {
   const base::flat_map<std::string, double> features{};
   const double result = LinregPredictNamed(features);
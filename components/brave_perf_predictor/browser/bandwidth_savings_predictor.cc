@@ -5,10 +5,7 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
-#include <iostream>
-
 #include "base/logging.h"
-#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
@@ -25,34 +22,37 @@ void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
+    features_[kFirstMeaningfulPaint] =
         timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
+    features_[kObservedDomContentLoaded] =
         timing.document_timing->dom_content_loaded_event_start.value()
             .InMillisecondsF();
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
+    features_[kObservedFirstVisualChange] =
         timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
+    features_[kObservedLoad] =
         timing.document_timing->load_event_start.value().InMillisecondsF();
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
     const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+  features_[kAdblockRequests] += 1;
 
   if (tp_registry_) {
     const auto tp_name = tp_registry_->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    if (tp_name.has_value()) {
+      const auto feature = GetThirdPartyBlockedFeature(tp_name.value());
+      if (feature.has_value())
+        features_[feature.value()] = 1;
+    }
   }
 }
 
@@ -73,47 +73,51 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
-        resource_load_info.raw_body_bytes;
+    features_[kThirdPartyRequestCount] += 1;
+    features_[kThirdPartySize] += resource_load_info.raw_body_bytes;
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
+  features_[kTotalRequestCount] += 1;
+  features_[kTotalSize] += resource_load_info.raw_body_bytes;
+  transfer_total_size_ += resource_load_info.total_received_bytes;
+
+  Feature request_count_feature;
+  Feature size_feature;
   switch (resource_load_info.request_destination) {
     case network::mojom::RequestDestination::kDocument:
-      resource_type = "document";
-      break;
     case network::mojom::RequestDestination::kIframe:
-      resource_type = "document";
+      request_count_feature = kDocumentRequestCount;
+      size_feature = kDocumentSize;
       break;
     case network::mojom::RequestDestination::kStyle:
-      resource_type = "stylesheet";
+      request_count_feature = kStylesheetRequestCount;
+      size_feature = kStylesheetSize;
       break;
     case network::mojom::RequestDestination::kScript:
-      resource_type = "script";
+      request_count_feature = kScriptRequestCount;
+      size_feature = kScriptSize;
       break;
     case network::mojom::RequestDestination::kImage:
-      resource_type = "image";
+      request_count_feature = kImageRequestCount;
+      size_feature = kImageSize;
       break;
     case network::mojom::RequestDestination::kFont:
-      resource_type = "font";
+      request_count_feature = kFontRequestCount;
+      size_feature = kFontSize;
       break;
     case network::mojom::RequestDestination::kAudio:
     case network::mojom::RequestDestination::kTrack:
     case network::mojom::RequestDestination::kVideo:
-      resource_type = "media";
+      request_count_feature = kMediaRequestCount;
+      size_feature = kMediaSize;
       break;
     default:
-      resource_type = "other";
+      request_count_feature = kOtherRequestCount;
+      size_feature = kOtherSize;
       break;
   }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  features_[request_count_feature] += 1;
+  features_[size_feature] += resource_load_info.raw_body_bytes;
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -121,37 +125,37 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
-            << " bytes";
+  if (transfer_total_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size "
+            << transfer_total_size_ << " bytes";
   } else {
     return 0;
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  if (features_[kAdblockRequests] < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
-    VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    VLOG(3) << "Predicting on features:";
+    for (unsigned int i = 0; i < feature_count; i++) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  double prediction = ::brave_perf_predictor::LinregPredictVector(features_);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   // Sanity check for predicted saving
   if (prediction > kSavingsAbsoluteOutlier &&
-      (prediction / kOutlierThreshold) > total_size->second) {
+      (prediction / kOutlierThreshold) > transfer_total_size_) {
     return 0;
   }
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  features_.fill(0);
+  transfer_total_size_ = 0;
   main_frame_url_ = {};
 }
 
@@ -7,7 +7,6 @@
 
 #include <memory>
 
-#include "base/containers/flat_map.h"
 #include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
@@ -39,45 +38,47 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
   predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
-            1);
+  EXPECT_EQ(predictor_->features_[kAdblockRequests], 1);
+  const auto google_analytics =
+      GetThirdPartyBlockedFeature("Google Analytics");
+  ASSERT_TRUE(google_analytics.has_value());
+  EXPECT_EQ(predictor_->features_[google_analytics.value()], 1);
   predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(predictor_->features_[kAdblockRequests], 2);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
+  EXPECT_EQ(predictor_->features_[kFirstMeaningfulPaint], 0);
+  EXPECT_EQ(predictor_->features_[kObservedDomContentLoaded], 0);
+  EXPECT_EQ(predictor_->features_[kObservedFirstVisualChange], 0);
+  EXPECT_EQ(predictor_->features_[kObservedLoad], 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::TimeDelta::FromMilliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(predictor_->features_[kObservedDomContentLoaded], 1000);
 
   timing->document_timing->load_event_start =
       base::TimeDelta::FromMilliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(predictor_->features_[kObservedLoad], 2000);
 
   timing->paint_timing->first_meaningful_paint =
       base::TimeDelta::FromMilliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(predictor_->features_[kFirstMeaningfulPaint], 1500);
 
   timing->paint_timing->first_contentful_paint =
       base::TimeDelta::FromMilliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(predictor_->features_[kObservedFirstVisualChange], 800);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(predictor_->features_[kThirdPartyRequestCount], 0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -86,9 +87,9 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       network::mojom::RequestDestination::kStyle);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(predictor_->features_[kThirdPartyRequestCount], 0);
+  EXPECT_EQ(predictor_->features_[kStylesheetRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kStylesheetSize], 1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -96,20 +97,37 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(predictor_->features_[kThirdPartyRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kStylesheetRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kScriptRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kStylesheetSize], 1000);
+  EXPECT_EQ(predictor_->features_[kScriptSize], 1001);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(predictor_->features_[kTotalRequestCount], 2);
+  EXPECT_EQ(predictor_->features_[kTotalSize], 2001);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
   EXPECT_EQ(predictor_->PredictSavingsBytes(), 0);
 }
 
+TEST_F(BandwidthSavingsPredictorTest, ResetClearsFeatures) {
+  const GURL main_frame("https://brave.com/");
+  auto res = predictors::CreateResourceLoadInfo(
+      "https://brave.com/style.css",
+      network::mojom::RequestDestination::kStyle);
+  res->raw_body_bytes = 1000;
+  res->total_received_bytes = 1000;
+  predictor_->OnResourceLoadComplete(main_frame, *res);
+  predictor_->OnSubresourceBlocked("https://google-analytics.com");
+
+  predictor_->Reset();
+  for (const double feature : predictor_->features_) {
+    EXPECT_EQ(feature, 0);
+  }
+  EXPECT_EQ(predictor_->transfer_total_size_, 0);
+}
+
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroInternalUrl) {
   const GURL main_frame("brave://version");
   auto res = predictors::CreateResourceLoadInfo("brave://version");
@@ -19,9 +19,14 @@ const int64_t kChunkSize = 1024;
 
 int64_t SeekNumLines(
     base::File* file,
-    const int num_lines) {
+    const int num_lines,
+    int* lines_found) {
   DCHECK(file);
 
+  if (lines_found) {
+    *lines_found = 0;
+  }
+
   if (num_lines == 0) {
     return 0;
   }
@@ -63,6 +68,9 @@ int64_t SeekNumLines(
       if (chunk[i] == '\n') {
         line_count++;
         if (line_count == num_lines + 1) {
+          if (lines_found) {
+            *lines_found = num_lines;
+          }
           return length;
         }
       }
@@ -73,6 +81,10 @@ int64_t SeekNumLines(
     last_chunk_size = chunk_size;
   } while (length > 0);
 
+  if (lines_found) {
+    *lines_found = line_count;
+  }
+
   return length;
 }
 
@@ -141,7 +153,7 @@ bool TailFile(
     return true;
   }
 
-  const int64_t offset = SeekNumLines(file, num_lines);
+  const int64_t offset = SeekNumLines(file, num_lines, nullptr);
   if (offset == -1) {
     return false;
   }
@@ -166,7 +178,7 @@ bool TailFileAsString(
   if (num_lines == -1) {
     offset = 0;
   } else {
-    offset = SeekNumLines(file, num_lines);
+    offset = SeekNumLines(file, num_lines, nullptr);
     if (offset == -1) {
       return false;
     }
@@ -175,6 +187,30 @@ bool TailFileAsString(
   return TruncateFileFromEndAsString(file, offset, value);
 }
 
+bool TailFileAsString(
+    base::File* file,
+    const int num_lines,
+    std::string* value,
+    int* lines_found) {
+  DCHECK(file);
+  DCHECK(value);
+  DCHECK(lines_found);
+
+  *lines_found = 0;
+
+  if (file->GetLength() == 0) {
+    *value = "";
+    return true;
+  }
+
+  const int64_t offset = SeekNumLines(file, num_lines, lines_found);
+  if (offset == -1) {
+    return false;
+  }
+
+  return TruncateFileFromEndAsString(file, offset, value);
+}
+
 std::string GetLastFileError(
     base::File* file) {
   DCHECK(file);
@@ -21,6 +21,14 @@ bool TailFileAsString(
     const int num_lines,
     std::string* value);
 
+// Like |TailFileAsString| but also reports how many complete lines were read,
+// which can be less than |num_lines| if the file is shorter
+bool TailFileAsString(
+    base::File* file,
+    const int num_lines,
+    std::string* value,
+    int* lines_found);
+
 std::string GetLastFileError(
     base::File* file);
 
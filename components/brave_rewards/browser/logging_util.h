@@ -13,6 +13,14 @@
 
 namespace brave_rewards {
 
+struct DiagnosticLogEntry {
+  base::Time time;
+  std::string file;
+  int line = 0;
+  int verbose_level = 0;
+  std::string message;
+};
+
 bool InitializeLog(
     base::File* file,
     const base::FilePath& path);
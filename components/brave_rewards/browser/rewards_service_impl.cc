@@ -41,7 +41,6 @@
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "brave/components/brave_ads/browser/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/browser/android_util.h"
-#include "brave/components/brave_rewards/browser/file_util.h"
 #include "brave/components/brave_rewards/browser/logging.h"
 #include "brave/components/brave_rewards/browser/logging_util.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
@@ -101,8 +100,8 @@ static const unsigned int kRetriesCountOnNetworkChange = 1;
 namespace {
 
 const int kDiagnosticLogMaxVerboseLevel = 6;
-const int kTailDiagnosticLogToNumLines = 20000;
 const int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
+const int kDiagnosticLogMaxSegments = 4;
 const char pref_prefix[] = "brave.rewards";
 
 std::string URLMethodToRequestType(ledger::type::UrlMethod method) {
@@ -307,7 +306,9 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
           {base::ThreadPool(), base::MayBlock(),
            base::TaskPriority::USER_VISIBLE,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
-      diagnostic_log_path_(profile_->GetPath().Append(kDiagnosticLogPath)),
+      diagnostic_log_(profile_->GetPath().Append(kDiagnosticLogPath),
+          kDiagnosticLogMaxFileSize / kDiagnosticLogMaxSegments,
+          kDiagnosticLogMaxSegments),
       ledger_state_path_(profile_->GetPath().Append(kLedger_state)),
       publisher_state_path_(profile_->GetPath().Append(kPublisher_state)),
       publisher_info_db_path_(profile->GetPath().Append(kPublisher_info_db)),
@@ -1392,11 +1393,10 @@ bool RewardsServiceImpl::ResetOnFilesTaskRunner() {
     ledger_state_path_,
     publisher_state_path_,
     publisher_info_db_path_,
-    diagnostic_log_path_,
     publisher_list_path_,
   };
 
-  bool res = true;
+  bool res = diagnostic_log_.Delete();
   for (size_t i = 0; i < paths.size(); i++) {
     if (!base::DeletePathRecursively(paths[i])) {
       res = false;
@@ -2217,90 +2217,74 @@ void RewardsServiceImpl::ShowNotificationTipsPaid(bool ac_enabled) {
       "rewards_notification_tips_processed");
 }
 
-bool RewardsServiceImpl::MaybeTailDiagnosticLog(
-    const int num_lines) {
-  if (!diagnostic_log_.IsValid()) {
-    return false;
+void RewardsServiceImpl::DiagnosticLog(
+    const std::string& file,
+    const int line,
+    const int verbose_level,
+    const std::string& message) {
+  if (ledger_for_testing_ || !should_persist_logs_) {
+    return;
   }
 
-  static bool first_run = true;
-
-  const int64_t length = diagnostic_log_.GetLength();
-  if (length == -1) {
-    return false;
+  if (resetting_rewards_) {
+    return;
   }
 
-  if (!first_run && length <= kDiagnosticLogMaxFileSize) {
-    return true;
+  if (verbose_level > kDiagnosticLogMaxVerboseLevel) {
+    return;
   }
 
-  first_run = false;
+  // Entries logged before the flush runs are written with a single file task
+  const bool flush_pending = !pending_diagnostic_log_entries_.empty();
 
-  if (!TailFile(&diagnostic_log_, num_lines)) {
-    return false;
+  DiagnosticLogEntry entry;
+  entry.time = base::Time::Now();
+  entry.file = file;
+  entry.line = line;
+  entry.verbose_level = verbose_level;
+  entry.message = message;
+  pending_diagnostic_log_entries_.push_back(std::move(entry));
+
+  if (flush_pending) {
+    return;
   }
 
-  return true;
+  base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+      base::BindOnce(&RewardsServiceImpl::FlushDiagnosticLog,
+          AsWeakPtr()));
 }
 
-void RewardsServiceImpl::DiagnosticLog(
-    const std::string& file,
-    const int line,
-    const int verbose_level,
-    const std::string& message) {
-  if (ledger_for_testing_ || !should_persist_logs_) {
+void RewardsServiceImpl::FlushDiagnosticLog() {
+  if (pending_diagnostic_log_entries_.empty()) {
     return;
   }
 
-  if (resetting_rewards_) {
-    return;
-  }
+  std::vector<DiagnosticLogEntry> entries;
+  entries.swap(pending_diagnostic_log_entries_);
 
-  if (verbose_level > kDiagnosticLogMaxVerboseLevel) {
+  if (resetting_rewards_) {
     return;
   }
 
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
-          diagnostic_log_path_,
-          kTailDiagnosticLogToNumLines,
-          file,
-          line,
-          verbose_level,
-          message),
+          std::move(entries)),
       base::BindOnce(&RewardsServiceImpl::OnWriteToLogOnFileTaskRunner,
           AsWeakPtr()));
 }
 
 bool RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& log_path,
-    const int num_lines,
-    const std::string& file,
-    const int line,
-    const int verbose_level,
-    const std::string& message) {
-  if (!InitializeLog(&diagnostic_log_, log_path)) {
-    VLOG(0) << "Failed to initialize diagnostic log: "
-        << GetLastFileError(&diagnostic_log_);
-
-    return false;
+    const std::vector<DiagnosticLogEntry>& entries) {
+  std::string log_entries;
+  for (const auto& entry : entries) {
+    log_entries += FriendlyFormatLogEntry(entry.time, entry.file, entry.line,
+        entry.verbose_level, entry.message);
   }
 
-  const base::Time time = base::Time::Now();
-
-  const std::string log_entry =
-      FriendlyFormatLogEntry(time, file, line, verbose_level, message);
-
-  if (!WriteToLog(&diagnostic_log_, log_entry)) {
+  if (!diagnostic_log_.Write(log_entries)) {
     VLOG(0) << "Failed to write to diagnostic log: "
-        << GetLastFileError(&diagnostic_log_);
-
-    return false;
-  }
-
-  if (!MaybeTailDiagnosticLog(num_lines)) {
-    VLOG(0) << "Failed to vacuum diagnostic log";
+        << diagnostic_log_.GetLastError();
 
     return false;
   }
@@ -2319,7 +2303,6 @@ void RewardsServiceImpl::LoadDiagnosticLog(
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::LoadDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
-          diagnostic_log_path_,
           num_lines),
       base::BindOnce(&RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner,
           AsWeakPtr(),
@@ -2327,16 +2310,11 @@ void RewardsServiceImpl::LoadDiagnosticLog(
 }
 
 std::string RewardsServiceImpl::LoadDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& path,
     const int num_lines) {
-  if (!base::PathExists(path)) {
-    return "";
-  }
-
   std::string value;
-  if (!TailFileAsString(&diagnostic_log_, num_lines, &value)) {
+  if (!diagnostic_log_.Read(num_lines, &value)) {
     return base::StringPrintf("ERROR: %s",
-        GetLastFileError(&diagnostic_log_).c_str());
+        diagnostic_log_.GetLastError().c_str());
   }
 
   return value;
@@ -2350,24 +2328,18 @@ void RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner(
 
 void RewardsServiceImpl::ClearDiagnosticLog(
     ClearDiagnosticLogCallback callback) {
+  pending_diagnostic_log_entries_.clear();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner,
-          base::Unretained(this),
-          diagnostic_log_path_),
+          base::Unretained(this)),
       base::BindOnce(&RewardsServiceImpl::OnClearDiagnosticLogOnFileTaskRunner,
           AsWeakPtr(),
           std::move(callback)));
 }
 
-bool RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner(
-    const base::FilePath& path) {
-  if (!base::PathExists(path)) {
-    return true;
-  }
-
-  diagnostic_log_.Close();
-
-  return base::DeleteFile(path);
+bool RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner() {
+  return diagnostic_log_.Delete();
 }
 
 void RewardsServiceImpl::OnClearDiagnosticLogOnFileTaskRunner(
@@ -3351,7 +3323,8 @@ void RewardsServiceImpl::WalletDisconnected(const std::string& wallet_type) {
 }
 
 void RewardsServiceImpl::DeleteLog(ledger::ResultCallback callback) {
-  diagnostic_log_.Close();
+  pending_diagnostic_log_entries_.clear();
+
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
@@ -3365,7 +3338,7 @@ void RewardsServiceImpl::DeleteLog(ledger::ResultCallback callback) {
 }
 
 bool RewardsServiceImpl::DeleteLogTaskRunner() {
-  return base::DeleteFile(diagnostic_log_path_);
+  return diagnostic_log_.Delete();
 }
 
 void RewardsServiceImpl::OnDeleteLog(
@@ -24,7 +24,9 @@
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
+#include "brave/components/brave_rewards/browser/logging_util.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
+#include "brave/components/brave_rewards/browser/segmented_log.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
@@ -575,22 +577,16 @@ class RewardsServiceImpl : public RewardsService,
       SavePublisherInfoCallback callback,
       const ledger::type::Result result);
 
-  bool MaybeTailDiagnosticLog(
-      const int num_lines);
-
   void DiagnosticLog(
       const std::string& file,
       const int line,
       const int verbose_level,
       const std::string& message) override;
 
+  void FlushDiagnosticLog();
+
   bool WriteToDiagnosticLogOnFileTaskRunner(
-      const base::FilePath& log_path,
-      const int num_lines,
-      const std::string& file,
-      const int line,
-      const int verbose_level,
-      const std::string& message);
+      const std::vector<DiagnosticLogEntry>& entries);
 
   void OnWriteToLogOnFileTaskRunner(
     const bool success);
@@ -600,7 +596,6 @@ class RewardsServiceImpl : public RewardsService,
       LoadDiagnosticLogCallback callback) override;
 
   std::string LoadDiagnosticLogOnFileTaskRunner(
-      const base::FilePath& path,
       const int num_lines);
 
   void OnLoadDiagnosticLogOnFileTaskRunner(
@@ -611,8 +606,7 @@ class RewardsServiceImpl : public RewardsService,
 
   void CompleteReset(SuccessCallback callback) override;
 
-  bool ClearDiagnosticLogOnFileTaskRunner(
-      const base::FilePath& path);
+  bool ClearDiagnosticLogOnFileTaskRunner();
 
   void OnClearDiagnosticLogOnFileTaskRunner(
       ClearDiagnosticLogCallback callback,
@@ -781,8 +775,8 @@ class RewardsServiceImpl : public RewardsService,
   mojo::AssociatedRemote<bat_ledger::mojom::BatLedger> bat_ledger_;
   mojo::Remote<bat_ledger::mojom::BatLedgerService> bat_ledger_service_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
-  const base::FilePath diagnostic_log_path_;
-  base::File diagnostic_log_;
+  SegmentedLog diagnostic_log_;
+  std::vector<DiagnosticLogEntry> pending_diagnostic_log_entries_;
   const base::FilePath ledger_state_path_;
   const base::FilePath publisher_state_path_;
   const base::FilePath publisher_info_db_path_;
@@ -0,0 +1,166 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/segmented_log.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_rewards/browser/file_util.h"
+#include "brave/components/brave_rewards/browser/logging_util.h"
+
+namespace brave_rewards {
+
+SegmentedLog::SegmentedLog(
+    const base::FilePath& path,
+    const int64_t max_segment_size,
+    const int max_segments)
+    : path_(path),
+      max_segment_size_(max_segment_size),
+      max_segments_(max_segments) {
+  DCHECK_GT(max_segment_size_, 0);
+  DCHECK_GT(max_segments_, 0);
+}
+
+SegmentedLog::~SegmentedLog() = default;
+
+bool SegmentedLog::Write(
+    const std::string& log_entries) {
+  if (!InitializeLog(&file_, path_)) {
+    return false;
+  }
+
+  if (!WriteToLog(&file_, log_entries)) {
+    return false;
+  }
+
+  const int64_t length = file_.GetLength();
+  if (length == -1) {
+    return false;
+  }
+
+  if (length <= max_segment_size_) {
+    return true;
+  }
+
+  return Rotate();
+}
+
+bool SegmentedLog::Read(
+    const int num_lines,
+    std::string* value) {
+  DCHECK(value);
+
+  // Walk from the newest segment to the oldest, only opening older segments
+  // while more lines are needed
+  std::vector<std::string> segments;
+  int remaining_lines = num_lines;
+  for (int i = 0; i < max_segments_; i++) {
+    if (num_lines != -1 && remaining_lines <= 0) {
+      break;
+    }
+
+    const base::FilePath segment_path = GetSegmentPath(i);
+    if (!base::PathExists(segment_path)) {
+      // The newest segment can be missing if it was deleted externally, but
+      // older segments may still hold lines
+      if (i == 0) {
+        continue;
+      }
+
+      break;
+    }
+
+    base::File segment(segment_path,
+        base::File::FLAG_OPEN | base::File::FLAG_READ);
+    if (!segment.IsValid()) {
+      return false;
+    }
+
+    std::string segment_value;
+    if (num_lines == -1) {
+      if (!TailFileAsString(&segment, -1, &segment_value)) {
+        return false;
+      }
+    } else {
+      int lines_found = 0;
+      if (!TailFileAsString(&segment, remaining_lines, &segment_value,
+          &lines_found)) {
+        return false;
+      }
+
+      remaining_lines -= lines_found;
+    }
+
+    segments.push_back(std::move(segment_value));
+  }
+
+  value->clear();
+  for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+    value->append(*it);
+  }
+
+  return true;
+}
+
+bool SegmentedLog::Delete() {
+  Close();
+
+  bool success = true;
+  for (int i = 0; i < max_segments_; i++) {
+    if (!base::DeleteFile(GetSegmentPath(i))) {
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+void SegmentedLog::Close() {
+  file_.Close();
+}
+
+std::string SegmentedLog::GetLastError() {
+  return GetLastFileError(&file_);
+}
+
+base::FilePath SegmentedLog::GetSegmentPath(
+    const int index) const {
+  if (index == 0) {
+    return path_;
+  }
+
+  return path_.AddExtensionASCII(base::NumberToString(index));
+}
+
+bool SegmentedLog::Rotate() {
+  // Close the newest segment before renaming it (required on Windows)
+  Close();
+
+  const base::FilePath oldest_path = GetSegmentPath(max_segments_ - 1);
+  if (!base::DeleteFile(oldest_path)) {
+    return false;
+  }
+
+  for (int i = max_segments_ - 2; i >= 0; i--) {
+    const base::FilePath segment_path = GetSegmentPath(i);
+    if (!base::PathExists(segment_path)) {
+      continue;
+    }
+
+    if (!base::Move(segment_path, GetSegmentPath(i + 1))) {
+      return false;
+    }
+  }
+
+  // Recreate an empty newest segment so that |path_| always exists after a
+  // rotation
+  return InitializeLog(&file_, path_);
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,65 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_SEGMENTED_LOG_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_SEGMENTED_LOG_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+
+namespace brave_rewards {
+
+// Log file split into up to |max_segments| segment files. Entries are only
+// ever appended to the newest segment at |path|. Once it grows past
+// |max_segment_size| the oldest segment is deleted and the others are renamed
+// one step older, so existing log data is never rewritten. All methods block
+// and must be called on the same sequence.
+class SegmentedLog {
+ public:
+  SegmentedLog(
+      const base::FilePath& path,
+      const int64_t max_segment_size,
+      const int max_segments);
+  ~SegmentedLog();
+
+  SegmentedLog(const SegmentedLog&) = delete;
+  SegmentedLog& operator=(const SegmentedLog&) = delete;
+
+  // Appends |log_entries|, which may hold several newline terminated entries,
+  // with a single write
+  bool Write(const std::string& log_entries);
+
+  // Returns the last |num_lines| lines across all segments, or every line if
+  // |num_lines| is -1. Only the segments holding those lines are read
+  bool Read(
+      const int num_lines,
+      std::string* value);
+
+  bool Delete();
+
+  void Close();
+
+  std::string GetLastError();
+
+ private:
+  base::FilePath GetSegmentPath(
+      const int index) const;
+
+  bool Rotate();
+
+  const base::FilePath path_;
+  const int64_t max_segment_size_;
+  const int max_segments_;
+
+  base::File file_;
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_SEGMENTED_LOG_H_
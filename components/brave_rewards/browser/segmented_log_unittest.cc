@@ -0,0 +1,161 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/segmented_log.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=SegmentedLogTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+const int64_t kMaxSegmentSize = 64;
+const int kMaxSegments = 3;
+
+std::string GetLine(const int index) {
+  return "line " + base::NumberToString(index) + "\n";
+}
+
+}  // namespace
+
+class SegmentedLogTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("Rewards.log");
+  }
+
+  base::FilePath GetSegmentPath(const int index) const {
+    return path_.AddExtensionASCII(base::NumberToString(index));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(SegmentedLogTest, ReadEmpty) {
+  SegmentedLog log(path_, kMaxSegmentSize, kMaxSegments);
+
+  std::string value = "foo";
+  EXPECT_TRUE(log.Read(10, &value));
+  EXPECT_EQ(value, "");
+}
+
+TEST_F(SegmentedLogTest, WriteAndReadLastLines) {
+  SegmentedLog log(path_, kMaxSegmentSize, kMaxSegments);
+
+  ASSERT_TRUE(log.Write(GetLine(1) + GetLine(2)));
+  ASSERT_TRUE(log.Write(GetLine(3)));
+
+  std::string value;
+  ASSERT_TRUE(log.Read(2, &value));
+  EXPECT_EQ(value, GetLine(2) + GetLine(3));
+
+  ASSERT_TRUE(log.Read(-1, &value));
+  EXPECT_EQ(value, GetLine(1) + GetLine(2) + GetLine(3));
+}
+
+TEST_F(SegmentedLogTest, RotatesSegments) {
+  SegmentedLog log(path_, kMaxSegmentSize, kMaxSegments);
+
+  // Each segment rotates after 9 lines, so the 100th write rotates and leaves
+  // an empty newest segment
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(log.Write(GetLine(i)));
+  }
+
+  EXPECT_TRUE(base::PathExists(path_));
+  EXPECT_TRUE(base::PathExists(GetSegmentPath(1)));
+  EXPECT_TRUE(base::PathExists(GetSegmentPath(2)));
+  EXPECT_FALSE(base::PathExists(GetSegmentPath(3)));
+
+  int64_t size = -1;
+  ASSERT_TRUE(base::GetFileSize(path_, &size));
+  EXPECT_EQ(size, 0);
+
+  for (int i = 1; i < kMaxSegments; i++) {
+    ASSERT_TRUE(base::GetFileSize(GetSegmentPath(i), &size));
+    EXPECT_GT(size, kMaxSegmentSize);
+    EXPECT_LE(size, kMaxSegmentSize + static_cast<int64_t>(
+        GetLine(99).size()));
+  }
+
+  // The tail spans several segments
+  std::string expected;
+  for (int i = 90; i < 100; i++) {
+    expected += GetLine(i);
+  }
+
+  std::string value;
+  ASSERT_TRUE(log.Read(10, &value));
+  EXPECT_EQ(value, expected);
+
+  // Only the last |kMaxSegments| - 1 full segments are kept
+  expected.clear();
+  for (int i = 82; i < 100; i++) {
+    expected += GetLine(i);
+  }
+
+  ASSERT_TRUE(log.Read(-1, &value));
+  EXPECT_EQ(value, expected);
+}
+
+TEST_F(SegmentedLogTest, WritesToNewestSegmentAfterRotation) {
+  SegmentedLog log(path_, kMaxSegmentSize, kMaxSegments);
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(log.Write(GetLine(i)));
+  }
+
+  ASSERT_TRUE(log.Write(GetLine(100)));
+
+  std::string value;
+  ASSERT_TRUE(base::ReadFileToString(path_, &value));
+  EXPECT_EQ(value, GetLine(100));
+
+  ASSERT_TRUE(log.Read(2, &value));
+  EXPECT_EQ(value, GetLine(99) + GetLine(100));
+}
+
+TEST_F(SegmentedLogTest, ReadSkipsMissingNewestSegment) {
+  SegmentedLog log(path_, kMaxSegmentSize, kMaxSegments);
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(log.Write(GetLine(i)));
+  }
+
+  log.Close();
+  ASSERT_TRUE(base::DeleteFile(path_));
+
+  std::string value;
+  ASSERT_TRUE(log.Read(1, &value));
+  EXPECT_EQ(value, GetLine(99));
+}
+
+TEST_F(SegmentedLogTest, Delete) {
+  SegmentedLog log(path_, kMaxSegmentSize, kMaxSegments);
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(log.Write(GetLine(i)));
+  }
+
+  EXPECT_TRUE(log.Delete());
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_FALSE(base::PathExists(GetSegmentPath(1)));
+  EXPECT_FALSE(base::PathExists(GetSegmentPath(2)));
+
+  std::string value;
+  ASSERT_TRUE(log.Read(10, &value));
+  EXPECT_EQ(value, "");
+}
+
+}  // namespace brave_rewards
@@ -22,6 +22,7 @@
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 
 class AdBlockServiceTest;
+class BraveRequestHandlerReplayTest;
 
 using brave_component_updater::BraveComponent;
 namespace adblock {
@@ -58,6 +59,7 @@ class AdBlockBaseService : public BaseBraveShieldsService {
 
  protected:
   friend class ::AdBlockServiceTest;
+  friend class ::BraveRequestHandlerReplayTest;
   bool Init() override;
 
   void GetDATFileData(const base::FilePath& dat_file_path);
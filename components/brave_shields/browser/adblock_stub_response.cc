@@ -10,9 +10,15 @@
 
 #include "base/compiler_specific.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/no_destructor.h"
-#include "base/strings/string_split.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
 #include "net/base/data_url.h"
+#include "net/http/http_response_headers.h"
 #include "net/http/http_util.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
@@ -98,77 +104,181 @@ const unsigned char kJpeg1x1[] = {
 // 'Accept' header that starts with "image/webp". However, it is possible to
 // craft a custom 'Accept', for example, using XHR, so we provide stubs for
 // other popular mime types.
-std::string GetContentForMimeType(const std::string& mime_type) {
-  static const base::NoDestructor<base::flat_map<std::string, std::string>>
+// The stubs are shared by every response that uses them instead of being
+// copied per request.
+scoped_refptr<base::RefCountedString> MakeContent(const unsigned char* begin,
+                                                  const unsigned char* end) {
+  std::string content(begin, end);
+  return base::RefCountedString::TakeString(&content);
+}
+
+scoped_refptr<base::RefCountedString> GetEmptyContent() {
+  static const base::NoDestructor<scoped_refptr<base::RefCountedString>> empty(
+      base::MakeRefCounted<base::RefCountedString>());
+  return *empty;
+}
+
+scoped_refptr<base::RefCountedString> GetContentForMimeType(
+    const std::string& mime_type) {
+  static const base::NoDestructor<
+      base::flat_map<std::string, scoped_refptr<base::RefCountedString>>>
       content({
-          {"image/avif", {kAvif1x1, std::end(kAvif1x1)}},
-          {"image/webp", {kWebp1x1, std::end(kWebp1x1)}},
-          {"image/*", {kPng1x1, std::end(kPng1x1)}},
-          {"image/apng", {kPng1x1, std::end(kPng1x1)}},
-          {"image/png", {kPng1x1, std::end(kPng1x1)}},
-          {"image/x-png", {kPng1x1, std::end(kPng1x1)}},
-          {"image/gif", {kGif1x1, std::end(kGif1x1)}},
-          {"image/jpeg", {kJpeg1x1, std::end(kJpeg1x1)}},
+          {"image/avif", MakeContent(kAvif1x1, std::end(kAvif1x1))},
+          {"image/webp", MakeContent(kWebp1x1, std::end(kWebp1x1))},
+          {"image/*", MakeContent(kPng1x1, std::end(kPng1x1))},
+          {"image/apng", MakeContent(kPng1x1, std::end(kPng1x1))},
+          {"image/png", MakeContent(kPng1x1, std::end(kPng1x1))},
+          {"image/x-png", MakeContent(kPng1x1, std::end(kPng1x1))},
+          {"image/gif", MakeContent(kGif1x1, std::end(kGif1x1))},
+          {"image/jpeg", MakeContent(kJpeg1x1, std::end(kJpeg1x1))},
       });
   auto it = content->find(mime_type);
   if (it == content->end()) {
-    return {};
+    return GetEmptyContent();
   }
   return it->second;
 }
 
+// Returns the first non-empty entry of an 'Accept' header, without any
+// parameters, e.g. "image/webp" for "image/webp,image/apng,*/*;q=0.8".
+base::StringPiece GetFirstAcceptedMimeType(base::StringPiece accept_header) {
+  size_t start = 0;
+  while (start < accept_header.size()) {
+    size_t end = accept_header.find_first_of(",;", start);
+    if (end == base::StringPiece::npos)
+      end = accept_header.size();
+    base::StringPiece mime_type = base::TrimWhitespaceASCII(
+        accept_header.substr(start, end - start), base::TRIM_ALL);
+    if (!mime_type.empty())
+      return mime_type;
+    start = end + 1;
+  }
+  return base::StringPiece();
+}
+
+// A decoded ad-block redirect resource. Mock data URLs come from a small,
+// fixed set of resources in the ad-block engine, so they are decoded once
+// and then shared by every request that is redirected to them.
+struct DecodedDataURL : public base::RefCountedThreadSafe<DecodedDataURL> {
+  bool is_valid = false;
+  std::string mime_type;
+  scoped_refptr<base::RefCountedString> data;
+
+ private:
+  friend class base::RefCountedThreadSafe<DecodedDataURL>;
+  ~DecodedDataURL() = default;
+};
+
+// Enough for every resource the ad-block engine ships with.
+constexpr size_t kMaxDecodedDataURLs = 128;
+
+scoped_refptr<const DecodedDataURL> DecodeDataURL(const std::string& data_url) {
+  static base::NoDestructor<base::Lock> lock;
+  static base::NoDestructor<
+      base::HashingMRUCache<std::string, scoped_refptr<const DecodedDataURL>>>
+      cache(kMaxDecodedDataURLs);
+
+  {
+    base::AutoLock auto_lock(*lock);
+    auto it = cache->Get(data_url);
+    if (it != cache->end())
+      return it->second;
+  }
+
+  auto decoded = base::MakeRefCounted<DecodedDataURL>();
+  std::string charset;
+  std::string data;
+  decoded->is_valid = net::DataURL::Parse(GURL(data_url), &decoded->mime_type,
+                                          &charset, &data);
+  decoded->data = base::RefCountedString::TakeString(&data);
+
+  base::AutoLock auto_lock(*lock);
+  cache->Put(data_url, decoded);
+  return decoded;
+}
+
+// Parsed headers for a stub response of |mime_type|. The headers are only
+// serialized into the response head and never modified afterwards, so a
+// single instance is shared by every stub response of that type.
+scoped_refptr<net::HttpResponseHeaders> GetHeadersForMimeType(
+    const std::string& mime_type) {
+  static base::NoDestructor<base::Lock> lock;
+  static base::NoDestructor<
+      base::flat_map<std::string, scoped_refptr<net::HttpResponseHeaders>>>
+      cache;
+  // Guard against unbounded growth from crafted 'Accept' headers.
+  constexpr size_t kMaxCachedHeaders = 64;
+
+  base::AutoLock auto_lock(*lock);
+  auto it = cache->find(mime_type);
+  if (it != cache->end())
+    return it->second;
+
+  if (cache->size() >= kMaxCachedHeaders)
+    cache->clear();
+
+  // TODO(iefremov): Allowing any origins still breaks some CORS requests.
+  // Maybe we can provide something smarter here (issues/4396).
+  std::string raw_headers =
+      "HTTP/1.1 200 OK\r\n"
+      "Access-Control-Allow-Origin: *\r\n"
+      "Content-Type: " +
+      mime_type + "\r\n";
+  auto headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+      net::HttpUtil::AssembleRawHeaders(raw_headers));
+  cache->emplace(mime_type, headers);
+  return headers;
+}
+
 }  // namespace
 
 void MakeStubResponse(const base::Optional<std::string>& data_url,
                       const network::ResourceRequest& request,
                       network::mojom::URLResponseHeadPtr* response,
-                      std::string* data) {
+                      scoped_refptr<base::RefCountedString>* data) {
   DCHECK(response && *response);
   DCHECK(data);
 
   (*response)->mime_type = "text/html";
-  *data = {};
+  *data = GetEmptyContent();
+
+  const bool has_data_url = data_url.has_value() && !data_url->empty();
 
   // Possibly overwrite mime and stub data.
   std::string accept_header;
   request.headers.GetHeader("Accept", &accept_header);
-  auto mime_types = base::SplitString(
-      accept_header, ",;", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-  if (!mime_types.empty()) {
-    DCHECK(!mime_types.front().empty());
+  base::StringPiece accepted_mime_type =
+      GetFirstAcceptedMimeType(accept_header);
+  if (!accepted_mime_type.empty()) {
     // If the entry looks like "*/*", use the default value. Otherwise, use
     // the value from 'Accept', even if it looks like "audio/*".
-    if (mime_types.front()[0] != '*') {
-      (*response)->mime_type = mime_types.front();
+    if (accepted_mime_type[0] != '*') {
+      (*response)->mime_type = accepted_mime_type.as_string();
     }
-    *data = GetContentForMimeType((*response)->mime_type);
+    // The data URL, if any, provides the content instead.
+    if (!has_data_url)
+      *data = GetContentForMimeType((*response)->mime_type);
   }
 
-  if (data_url.has_value() && !data_url->empty()) {
-    std::string charset;
-    std::string mime_type;
-    std::string url_data;
-    if (!net::DataURL::Parse(GURL(data_url.value()), &mime_type, &charset,
-                             &url_data)) {
+  if (has_data_url) {
+    scoped_refptr<const DecodedDataURL> decoded =
+        DecodeDataURL(data_url.value());
+    if (!decoded->is_valid) {
       LOG(ERROR) << "Could not parse ad-block data URL: " << data_url.value();
+      if (!accepted_mime_type.empty())
+        *data = GetContentForMimeType((*response)->mime_type);
     } else {
-      *data = std::move(url_data);
-      if (!mime_type.empty() && data_url.value().find("data:,") != 0) {
-        (*response)->mime_type = mime_type;
+      *data = decoded->data;
+      if (!decoded->mime_type.empty() &&
+          !base::StartsWith(data_url.value(), "data:,",
+                            base::CompareCase::SENSITIVE)) {
+        (*response)->mime_type = decoded->mime_type;
       }
     }
   }
 
   // Craft response headers.
-  // TODO(iefremov): Allowing any origins still breaks some CORS requests.
-  // Maybe we can provide something smarter here (issues/4396).
-  std::string raw_headers =
-      "HTTP/1.1 200 OK\r\n"
-      "Access-Control-Allow-Origin: *\r\n"
-      "Content-Type: " +
-      (*response)->mime_type + "\r\n";
-  (*response)->headers = new net::HttpResponseHeaders(
-      net::HttpUtil::AssembleRawHeaders(raw_headers));
+  (*response)->headers = GetHeadersForMimeType((*response)->mime_type);
 }
 
 }  // namespace brave_shields
@@ -7,9 +7,14 @@
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_ADBLOCK_STUB_RESPONSE_H_
 
 #include <string>
+#include "base/memory/scoped_refptr.h"
 #include "base/optional.h"
 #include "services/network/public/mojom/url_response_head.mojom-forward.h"
 
+namespace base {
+class RefCountedString;
+}  // namespace base
+
 namespace network {
 struct ResourceRequest;
 }  // namespace network
@@ -17,11 +22,12 @@ struct ResourceRequest;
 namespace brave_shields {
 
 // Intercepts certain requests and blocks them by silently returning 200 OK
-// and not allowing them to hit the network.
+// and not allowing them to hit the network. |data| and the response headers
+// are shared with other stub responses and must not be modified.
 void MakeStubResponse(const base::Optional<std::string>& data_url,
                       const network::ResourceRequest& request,
                       network::mojom::URLResponseHeadPtr* response,
-                      std::string* data);
+                      scoped_refptr<base::RefCountedString>* data);
 
 }  // namespace brave_shields
 
@@ -4,6 +4,8 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "brave/components/brave_shields/browser/adblock_stub_response.h"
+#include "base/memory/ref_counted_memory.h"
+#include "net/http/http_response_headers.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -11,50 +13,94 @@
 TEST(AdBlockStubResponse, ScriptDataURL) {
   std::string data_url =
       "data:application/script,<script>alert('hi');</script>";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, {}, &resource_response, &data);
-  ASSERT_EQ(data, "<script>alert('hi');</script>");
+  ASSERT_EQ(data->data(), "<script>alert('hi');</script>");
   ASSERT_EQ(resource_response->mime_type, "application/script");
 }
 
 TEST(AdBlockStubResponse, HTMLDataURL) {
   std::string data_url = "data:text/html,<strong>π</strong>";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, {}, &resource_response, &data);
-  ASSERT_EQ(data, "<strong>π</strong>");
+  ASSERT_EQ(data->data(), "<strong>π</strong>");
   ASSERT_EQ(resource_response->mime_type, "text/html");
 }
 
 TEST(AdBlockStubResponse, HTMLDataURLPrioritizedOverRequestInfo) {
   std::string data_url = "data:text/xml,pi";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   network::ResourceRequest request;
   request.headers.AddHeadersFromString("Accept: image/svg");
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, request, &resource_response, &data);
-  ASSERT_EQ(data, "pi");
+  ASSERT_EQ(data->data(), "pi");
   ASSERT_EQ(resource_response->mime_type, "text/xml");
 }
 
 TEST(AdBlockStubResponse, AcceptHeaderUsedNoDataURL) {
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   network::ResourceRequest request;
   request.headers.AddHeadersFromString("Accept: text/xml");
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse("", request, &resource_response, &data);
-  ASSERT_EQ(data, "");
+  ASSERT_EQ(data->data(), "");
   ASSERT_EQ(resource_response->mime_type, "text/xml");
 }
 
 TEST(AdBlockStubResponse, HTMLDataURLNoMimeTypeUsesAcceptHeader) {
   std::string data_url = "data:,<num>pi</num>";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   network::ResourceRequest request;
   request.headers.AddHeadersFromString("Accept: text/xml");
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, request, &resource_response, &data);
-  ASSERT_EQ(data, "<num>pi</num>");
+  ASSERT_EQ(data->data(), "<num>pi</num>");
   ASSERT_EQ(resource_response->mime_type, "text/xml");
 }
+
+TEST(AdBlockStubResponse, RepeatedDataURLIsDecodedConsistently) {
+  std::string data_url = "data:text/plain;base64,cGk=";
+  for (int i = 0; i < 3; ++i) {
+    scoped_refptr<base::RefCountedString> data;
+    network::ResourceRequest request;
+    auto resource_response = network::mojom::URLResponseHead::New();
+    brave_shields::MakeStubResponse(data_url, request, &resource_response,
+                                    &data);
+    ASSERT_EQ(data->data(), "pi");
+    ASSERT_EQ(resource_response->mime_type, "text/plain");
+    std::string content_type;
+    ASSERT_TRUE(resource_response->headers->GetNormalizedHeader(
+        "Content-Type", &content_type));
+    ASSERT_EQ(content_type, "text/plain");
+  }
+}
+
+TEST(AdBlockStubResponse, AcceptHeaderSkipsEmptyEntries) {
+  scoped_refptr<base::RefCountedString> data;
+  network::ResourceRequest request;
+  request.headers.AddHeadersFromString("Accept: , image/png;q=0.9, */*");
+  auto resource_response = network::mojom::URLResponseHead::New();
+  brave_shields::MakeStubResponse(base::nullopt, request, &resource_response,
+                                  &data);
+  ASSERT_FALSE(data->data().empty());
+  ASSERT_EQ(resource_response->mime_type, "image/png");
+}
+
+TEST(AdBlockStubResponse, RepeatedStubsShareBodyAndHeaders) {
+  network::ResourceRequest request;
+  request.headers.AddHeadersFromString("Accept: image/webp,*/*;q=0.8");
+  scoped_refptr<base::RefCountedString> first_data;
+  auto first_response = network::mojom::URLResponseHead::New();
+  brave_shields::MakeStubResponse(base::nullopt, request, &first_response,
+                                  &first_data);
+  scoped_refptr<base::RefCountedString> second_data;
+  auto second_response = network::mojom::URLResponseHead::New();
+  brave_shields::MakeStubResponse(base::nullopt, request, &second_response,
+                                  &second_data);
+  ASSERT_FALSE(first_data->data().empty());
+  ASSERT_EQ(first_data, second_data);
+  ASSERT_EQ(first_response->headers, second_response->headers);
+}
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_perf_predictor/browser/buildflags.h"
 #include "brave/components/brave_shields/browser/brave_shields_p3a.h"
@@ -45,6 +46,11 @@ void RecordShieldsSettingChanged(PrefService* local_state) {
 }
 
 
+const GURL& GetFirstPartyURL() {
+  static const base::NoDestructor<GURL> first_party_url("https://firstParty/");
+  return *first_party_url;
+}
+
 ContentSetting GetDefaultAllowFromControlType(ControlType type) {
   if (type == ControlType::DEFAULT)
     return CONTENT_SETTING_DEFAULT;
@@ -209,7 +215,7 @@ ControlType GetCosmeticFilteringControlType(HostContentSettingsMap* map,
       url, GURL(), ContentSettingsType::BRAVE_COSMETIC_FILTERING);
 
   ContentSetting fp_setting =
-      map->GetContentSetting(url, GURL("https://firstParty/"),
+      map->GetContentSetting(url, GetFirstPartyURL(),
                              ContentSettingsType::BRAVE_COSMETIC_FILTERING);
 
   if (setting == CONTENT_SETTING_ALLOW) {
@@ -265,7 +271,7 @@ ControlType GetCookieControlType(HostContentSettingsMap* map, const GURL& url) {
       map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_COOKIES);
 
   ContentSetting fp_setting = map->GetContentSetting(
-      url, GURL("https://firstParty/"), ContentSettingsType::BRAVE_COOKIES);
+      url, GetFirstPartyURL(), ContentSettingsType::BRAVE_COOKIES);
 
   if (setting == CONTENT_SETTING_ALLOW) {
     return ControlType::ALLOW;
@@ -449,4 +455,14 @@ bool MaybeChangeReferrer(
   return true;
 }
 
+ShieldsSettingsSnapshot GetShieldsSettingsSnapshot(HostContentSettingsMap* map,
+                                                   const GURL& url) {
+  ShieldsSettingsSnapshot snapshot;
+  snapshot.brave_shields_enabled = GetBraveShieldsEnabled(map, url);
+  snapshot.ad_control_type = GetAdControlType(map, url);
+  snapshot.https_everywhere_enabled = GetHTTPSEverywhereEnabled(map, url);
+  snapshot.allow_referrers = AllowReferrers(map, url);
+  return snapshot;
+}
+
 }  // namespace brave_shields
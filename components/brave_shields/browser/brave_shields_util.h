@@ -102,6 +102,18 @@ bool MaybeChangeReferrer(
     const GURL& target_url,
     content::Referrer* output_referrer);
 
+// Shields settings consulted for every network request of a page. Reading
+// them once per page avoids repeated HostContentSettingsMap lookups.
+struct ShieldsSettingsSnapshot {
+  bool brave_shields_enabled = true;
+  ControlType ad_control_type = ControlType::BLOCK;
+  bool https_everywhere_enabled = true;
+  bool allow_referrers = false;
+};
+
+ShieldsSettingsSnapshot GetShieldsSettingsSnapshot(HostContentSettingsMap* map,
+                                                   const GURL& url);
+
 
 }  // namespace brave_shields
 
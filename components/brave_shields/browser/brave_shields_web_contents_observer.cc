@@ -136,6 +136,8 @@ BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
     : WebContentsObserver(web_contents) {
+  content_settings_observer_.Add(HostContentSettingsMapFactory::GetForProfile(
+      Profile::FromBrowserContext(web_contents->GetBrowserContext())));
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameCreated(
@@ -177,6 +179,12 @@ void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
 
 void BraveShieldsWebContentsObserver::DidFinishNavigation(
     content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->IsInMainFrame() &&
+      navigation_handle->HasCommitted() &&
+      !navigation_handle->IsSameDocument()) {
+    settings_snapshot_.reset();
+  }
+
   RenderFrameHost* main_frame = web_contents()->GetMainFrame();
   if (!web_contents() || !main_frame) {
     return;
@@ -190,6 +198,26 @@ void BraveShieldsWebContentsObserver::DidFinishNavigation(
   frame_tree_node_id_to_tab_url_[tree_node_id] = web_contents()->GetURL();
 }
 
+void BraveShieldsWebContentsObserver::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  settings_snapshot_.reset();
+}
+
+const ShieldsSettingsSnapshot&
+BraveShieldsWebContentsObserver::GetShieldsSettingsSnapshot(
+    HostContentSettingsMap* map,
+    const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!settings_snapshot_ || settings_snapshot_url_ != tab_origin) {
+    settings_snapshot_url_ = tab_origin;
+    settings_snapshot_ =
+        ::brave_shields::GetShieldsSettingsSnapshot(map, tab_origin);
+  }
+  return *settings_snapshot_;
+}
+
 // static
 GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
     int render_process_id, int render_frame_id, int render_frame_tree_node_id) {
@@ -11,9 +11,15 @@
 #include <string>
 #include <vector>
 
+#include "base/gtest_prod_util.h"
 #include "base/macros.h"
+#include "base/optional.h"
+#include "base/scoped_observer.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -26,6 +32,7 @@ class PrefRegistrySimple;
 namespace brave_shields {
 
 class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
+    public content_settings::Observer,
     public content::WebContentsUserData<BraveShieldsWebContentsObserver> {
  public:
   explicit BraveShieldsWebContentsObserver(content::WebContents*);
@@ -48,6 +55,12 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  // Returns the shields settings for |tab_origin|, reusing the values read
+  // for the previous request until the page or any content setting changes.
+  // Must be called on the UI thread.
+  const ShieldsSettingsSnapshot& GetShieldsSettingsSnapshot(
+      HostContentSettingsMap* map,
+      const GURL& tab_origin);
 
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
@@ -75,6 +88,11 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
 
+  // content_settings::Observer overrides.
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
       content::RenderFrameHost* render_frame_host) override;
@@ -94,10 +112,20 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+  FRIEND_TEST_ALL_PREFIXES(BraveShieldsWebContentsObserverTest,
+                           SnapshotResetsOnMainFrameCommit);
+  FRIEND_TEST_ALL_PREFIXES(BraveShieldsWebContentsObserverTest,
+                           SnapshotResetsOnContentSettingChange);
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
+  // Cached settings for |settings_snapshot_url_|, see
+  // |GetShieldsSettingsSnapshot|.
+  GURL settings_snapshot_url_;
+  base::Optional<ShieldsSettingsSnapshot> settings_snapshot_;
+  ScopedObserver<HostContentSettingsMap, content_settings::Observer>
+      content_settings_observer_{this};
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
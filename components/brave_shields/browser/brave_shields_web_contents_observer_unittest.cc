@@ -0,0 +1,81 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BraveShieldsWebContentsObserver*
+
+namespace brave_shields {
+
+class BraveShieldsWebContentsObserverTest
+    : public ChromeRenderViewHostTestHarness {
+ public:
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+    BraveShieldsWebContentsObserver::CreateForWebContents(web_contents());
+  }
+
+  BraveShieldsWebContentsObserver* observer() {
+    return BraveShieldsWebContentsObserver::FromWebContents(web_contents());
+  }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile());
+  }
+};
+
+TEST_F(BraveShieldsWebContentsObserverTest, SnapshotResetsOnMainFrameCommit) {
+  const GURL url("https://a.com/");
+  NavigateAndCommit(url);
+
+  observer()->GetShieldsSettingsSnapshot(map(), url);
+  EXPECT_TRUE(observer()->settings_snapshot_);
+
+  NavigateAndCommit(GURL("https://a.com/other"));
+  EXPECT_FALSE(observer()->settings_snapshot_);
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest,
+       SnapshotResetsOnContentSettingChange) {
+  const GURL url("https://a.com/");
+  NavigateAndCommit(url);
+
+  EXPECT_TRUE(
+      observer()->GetShieldsSettingsSnapshot(map(), url).brave_shields_enabled);
+  EXPECT_TRUE(observer()->settings_snapshot_);
+
+  SetBraveShieldsEnabled(map(), false, url);
+  EXPECT_FALSE(observer()->settings_snapshot_);
+  EXPECT_FALSE(
+      observer()->GetShieldsSettingsSnapshot(map(), url).brave_shields_enabled);
+
+  SetAdControlType(map(), ControlType::ALLOW, url);
+  EXPECT_FALSE(observer()->settings_snapshot_);
+  EXPECT_EQ(ControlType::ALLOW,
+            observer()->GetShieldsSettingsSnapshot(map(), url).ad_control_type);
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, SnapshotIsNotSharedAcrossOrigins) {
+  const GURL a_url("https://a.com/");
+  const GURL b_url("https://b.com/");
+  SetBraveShieldsEnabled(map(), false, a_url);
+  NavigateAndCommit(a_url);
+
+  EXPECT_FALSE(observer()->GetShieldsSettingsSnapshot(map(), a_url)
+                   .brave_shields_enabled);
+  EXPECT_TRUE(observer()->GetShieldsSettingsSnapshot(map(), b_url)
+                  .brave_shields_enabled);
+  EXPECT_FALSE(observer()->GetShieldsSettingsSnapshot(map(), a_url)
+                   .brave_shields_enabled);
+}
+
+}  // namespace brave_shields
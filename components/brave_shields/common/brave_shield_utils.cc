@@ -5,36 +5,39 @@
 
 #include "brave/components/brave_shields/common/brave_shield_utils.h"
 
-#include "base/optional.h"
+#include "base/no_destructor.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "url/gurl.h"
 
 ContentSetting GetBraveFPContentSettingFromRules(
     const ContentSettingsForOneType& fp_rules,
     const GURL& primary_url) {
-  base::Optional<ContentSettingPatternSource> global_fp_rule;
-  base::Optional<ContentSettingPatternSource> global_fp_balanced_rule;
+  // Both patterns are compared against every rule, so build them only once.
+  static const base::NoDestructor<ContentSettingsPattern> wildcard(
+      ContentSettingsPattern::Wildcard());
+  static const base::NoDestructor<ContentSettingsPattern> balanced_pattern(
+      ContentSettingsPattern::FromString("https://balanced"));
+  const ContentSettingPatternSource* global_fp_rule = nullptr;
+  const ContentSettingPatternSource* global_fp_balanced_rule = nullptr;
 
   for (const auto& rule : fp_rules) {
-    if (rule.primary_pattern != ContentSettingsPattern::Wildcard() &&
-        rule.primary_pattern.Matches(primary_url)) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+    const bool is_global_rule = rule.primary_pattern == *wildcard;
+    if (!is_global_rule && rule.primary_pattern.Matches(primary_url)) {
+      if (rule.secondary_pattern == *balanced_pattern) {
         return CONTENT_SETTING_DEFAULT;
       }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard())
+      if (rule.secondary_pattern == *wildcard)
         return rule.GetContentSetting();
     }
 
-    if (rule.primary_pattern == ContentSettingsPattern::Wildcard()) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+    if (is_global_rule) {
+      if (rule.secondary_pattern == *balanced_pattern) {
         DCHECK(!global_fp_rule);
-        global_fp_balanced_rule = rule;
+        global_fp_balanced_rule = &rule;
       }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard()) {
+      if (rule.secondary_pattern == *wildcard) {
         DCHECK(!global_fp_balanced_rule);
-        global_fp_rule = rule;
+        global_fp_rule = &rule;
       }
     }
   }
@@ -5,11 +5,18 @@
 
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/optional.h"
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
 #include "base/task/post_task.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/pref_names.h"
@@ -89,8 +96,72 @@ class BraveShieldsRuleIterator : public RuleIterator {
 };
 
 
+// Returns |host| and all of its parent domains, followed by the empty host of
+// patterns matching all hosts. These are the only hosts a pattern can have to
+// be identical to or a successor of a pattern for |host|.
+std::vector<std::string> GetHostAndParentDomains(const std::string& host) {
+  std::vector<std::string> hosts;
+  base::StringPiece remaining(host);
+  while (!remaining.empty()) {
+    hosts.push_back(remaining.as_string());
+    const size_t dot = remaining.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    remaining.remove_prefix(dot + 1);
+  }
+  hosts.emplace_back();
+  return hosts;
+}
+
+// Shield rules indexed by the host of their primary pattern, so that matching a
+// cookie rule only compares it against the shield rules for its own host and
+// parent domains instead of scanning all of them.
+class ShieldRulesIndex {
+ public:
+  explicit ShieldRulesIndex(const std::vector<Rule>& shield_rules)
+      : shield_rules_(shield_rules) {
+    for (size_t i = 0; i < shield_rules_.size(); ++i)
+      rule_indices_[shield_rules_[i].primary_pattern.GetHost()].push_back(i);
+  }
+
+  // Returns the first shield rule, in precedence order, whose primary pattern
+  // is identical to or a successor of |pattern|, or nullptr if there is none.
+  const Rule* FindRule(const ContentSettingsPattern& pattern) const {
+    size_t match = shield_rules_.size();
+    for (const auto& host : GetHostAndParentDomains(pattern.GetHost())) {
+      auto it = rule_indices_.find(host);
+      if (it == rule_indices_.end())
+        continue;
+
+      // Indices are ascending, so only rules before the best match so far can
+      // take precedence over it.
+      for (size_t i : it->second) {
+        if (i >= match)
+          break;
+
+        auto primary_compare =
+            shield_rules_[i].primary_pattern.Compare(pattern);
+        // TODO(bridiver) - verify that SUCCESSOR is correct and not PREDECESSOR
+        if (primary_compare == ContentSettingsPattern::IDENTITY ||
+            primary_compare == ContentSettingsPattern::SUCCESSOR) {
+          match = i;
+          break;
+        }
+      }
+    }
+
+    return match < shield_rules_.size() ? &shield_rules_[match] : nullptr;
+  }
+
+ private:
+  const std::vector<Rule>& shield_rules_;
+  std::map<std::string, std::vector<size_t>> rule_indices_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldRulesIndex);
+};
+
 bool IsActive(const Rule& cookie_rule,
-              const std::vector<Rule>& shield_rules) {
+              const ShieldRulesIndex& shield_rules) {
   // don't include default rules in the iterator
   if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
       (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
@@ -99,20 +170,46 @@ bool IsActive(const Rule& cookie_rule,
     return false;
   }
 
-  bool default_value = true;
-  for (const auto& shield_rule : shield_rules) {
-    auto primary_compare =
-        shield_rule.primary_pattern.Compare(cookie_rule.primary_pattern);
-    // TODO(bridiver) - verify that SUCCESSOR is correct and not PREDECESSOR
-    if (primary_compare == ContentSettingsPattern::IDENTITY ||
-        primary_compare == ContentSettingsPattern::SUCCESSOR) {
-      // TODO(bridiver) - move this logic into shields_util for allow/block
-      return
-          ValueToContentSetting(&shield_rule.value) != CONTENT_SETTING_BLOCK;
-    }
-  }
+  const Rule* shield_rule = shield_rules.FindRule(cookie_rule.primary_pattern);
+  if (!shield_rule)
+    return true;
 
-  return default_value;
+  // TODO(bridiver) - move this logic into shields_util for allow/block
+  return ValueToContentSetting(&shield_rule->value) != CONTENT_SETTING_BLOCK;
+}
+
+// Returns true if a change to the shield rule for |shield_pattern| can change
+// whether |cookie_rule| is active.
+bool IsAffectedByShieldsChange(const Rule& cookie_rule,
+                               const ContentSettingsPattern& shield_pattern) {
+  if (shield_pattern.GetHost().empty())
+    return true;
+
+  return base::Contains(
+      GetHostAndParentDomains(cookie_rule.primary_pattern.GetHost()),
+      shield_pattern.GetHost());
+}
+
+using RuleKey =
+    std::tuple<ContentSettingsPattern, ContentSettingsPattern, ContentSetting>;
+
+RuleKey GetRuleKey(const Rule& rule) {
+  return RuleKey(rule.primary_pattern, rule.secondary_pattern,
+                 ValueToContentSetting(&rule.value));
+}
+
+std::set<RuleKey> GetRuleKeys(const std::vector<Rule>& rules) {
+  std::set<RuleKey> keys;
+  for (const auto& rule : rules)
+    keys.insert(GetRuleKey(rule));
+  return keys;
+}
+
+std::set<PatternPair> GetRulePatterns(const std::vector<Rule>& rules) {
+  std::set<PatternPair> patterns;
+  for (const auto& rule : rules)
+    patterns.emplace(rule.primary_pattern, rule.secondary_pattern);
+  return patterns;
 }
 
 }  // namespace
@@ -146,7 +243,8 @@ BravePrefProvider::BravePrefProvider(PrefService* prefs,
 
   MigrateShieldsSettings(off_the_record);
 
-  OnCookieSettingsChanged(ContentSettingsType::BRAVE_COOKIES);
+  OnCookieSettingsChanged(ContentSettingsType::BRAVE_COOKIES,
+                          ContentSettingsPattern::Wildcard());
 
   // Enable change notifications after initial setup to avoid notification spam
   initialized_ = true;
@@ -438,8 +536,10 @@ std::unique_ptr<RuleIterator> BravePrefProvider::GetRuleIterator(
   return PrefProvider::GetRuleIterator(content_type, incognito);
 }
 
-void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
-                                          bool incognito) {
+void BravePrefProvider::UpdateCookieRules(
+    ContentSettingsType content_type,
+    const ContentSettingsPattern& shields_pattern,
+    bool incognito) {
   auto& rules = cookie_rules_[incognito];
   auto old_rules = std::move(brave_cookie_rules_[incognito]);
 
@@ -498,14 +598,37 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
 
   brave_shields_iterator.reset();
 
-  // add brave cookies after checking shield status
-  auto brave_cookies_iterator = PrefProvider::GetRuleIterator(
-      ContentSettingsType::BRAVE_COOKIES, incognito);
+  const ShieldRulesIndex shield_rules_index(shield_rules);
+
+  auto& brave_cookie_pref_rules = brave_cookie_pref_rules_[incognito];
+  auto& brave_cookie_rules_active = brave_cookie_rules_active_[incognito];
+
+  // A shields toggle for a site only changes the cookie rules of that site and
+  // its subdomains, the other cookie rules keep their state.
+  const bool update_all_cookie_rules =
+      content_type != ContentSettingsType::BRAVE_SHIELDS ||
+      brave_cookie_rules_active.size() != brave_cookie_pref_rules.size();
+  if (update_all_cookie_rules) {
+    brave_cookie_pref_rules.clear();
+    auto brave_cookies_iterator = PrefProvider::GetRuleIterator(
+        ContentSettingsType::BRAVE_COOKIES, incognito);
+    while (brave_cookies_iterator && brave_cookies_iterator->HasNext()) {
+      brave_cookie_pref_rules.emplace_back(brave_cookies_iterator->Next());
+    }
+
+    brave_cookie_rules_active.assign(brave_cookie_pref_rules.size(), false);
+  }
 
   // Matching cookie rules against shield rules.
-  while (brave_cookies_iterator && brave_cookies_iterator->HasNext()) {
-    auto rule = brave_cookies_iterator->Next();
-    if (IsActive(rule, shield_rules)) {
+  for (size_t i = 0; i < brave_cookie_pref_rules.size(); ++i) {
+    const auto& rule = brave_cookie_pref_rules[i];
+    if (update_all_cookie_rules ||
+        IsAffectedByShieldsChange(rule, shields_pattern)) {
+      brave_cookie_rules_active[i] = IsActive(rule, shield_rules_index);
+    }
+
+    // add brave cookies after checking shield status
+    if (brave_cookie_rules_active[i]) {
       rules.emplace_back(CloneRule(rule, true));
       brave_cookie_rules_[incognito].emplace_back(CloneRule(rule, true));
     }
@@ -536,35 +659,23 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
 
   // get the list of changes
   std::vector<Rule> brave_cookie_updates;
+  // we want an exact match here because any change to the rule is an update
+  const std::set<RuleKey> old_rule_keys = GetRuleKeys(old_rules);
   for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
+    if (!base::Contains(old_rule_keys, GetRuleKey(new_rule))) {
       brave_cookie_updates.emplace_back(CloneRule(new_rule));
     }
   }
 
   // find any removed rules
+  // we only care about the patterns here because we're looking for deleted
+  // rules, not changed rules
+  const std::set<PatternPair> new_rule_patterns =
+      GetRulePatterns(brave_cookie_rules_[incognito]);
   for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
+    if (!base::Contains(new_rule_patterns,
+                        PatternPair(old_rule.primary_pattern,
+                                    old_rule.secondary_pattern))) {
       brave_cookie_updates.emplace_back(
           Rule(old_rule.primary_pattern, old_rule.secondary_pattern,
                base::Value(), old_rule.expiration, old_rule.session_model));
@@ -594,13 +705,15 @@ void BravePrefProvider::NotifyChanges(const std::vector<Rule>& rules,
 
 void BravePrefProvider::OnCookiePrefsChanged(
     const std::string& pref) {
-  OnCookieSettingsChanged(ContentSettingsType::BRAVE_COOKIES);
+  OnCookieSettingsChanged(ContentSettingsType::BRAVE_COOKIES,
+                          ContentSettingsPattern::Wildcard());
 }
 
 void BravePrefProvider::OnCookieSettingsChanged(
-    ContentSettingsType content_type) {
-  UpdateCookieRules(content_type, true);
-  UpdateCookieRules(content_type, false);
+    ContentSettingsType content_type,
+    const ContentSettingsPattern& shields_pattern) {
+  UpdateCookieRules(content_type, shields_pattern, true);
+  UpdateCookieRules(content_type, shields_pattern, false);
 }
 
 void BravePrefProvider::OnContentSettingChanged(
@@ -610,7 +723,7 @@ void BravePrefProvider::OnContentSettingChanged(
   if (content_type == ContentSettingsType::COOKIES ||
       content_type == ContentSettingsType::BRAVE_COOKIES ||
       content_type == ContentSettingsType::BRAVE_SHIELDS) {
-    OnCookieSettingsChanged(content_type);
+    OnCookieSettingsChanged(content_type, primary_pattern);
   }
 }
 
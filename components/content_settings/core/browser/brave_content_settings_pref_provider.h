@@ -68,8 +68,14 @@ class BravePrefProvider : public PrefProvider,
       int setting);
   void MigrateShieldsSettingsV1ToV2();
   void MigrateShieldsSettingsV1ToV2ForOneType(ContentSettingsType content_type);
-  void UpdateCookieRules(ContentSettingsType content_type, bool incognito);
-  void OnCookieSettingsChanged(ContentSettingsType content_type);
+  // |shields_pattern| is the primary pattern of a changed shields setting. When
+  // |content_type| is BRAVE_SHIELDS only the cookie rules it may affect are
+  // matched against shield rules again.
+  void UpdateCookieRules(ContentSettingsType content_type,
+                         const ContentSettingsPattern& shields_pattern,
+                         bool incognito);
+  void OnCookieSettingsChanged(ContentSettingsType content_type,
+                               const ContentSettingsPattern& shields_pattern);
   void NotifyChanges(const std::vector<Rule>& rules, bool incognito);
   bool SetWebsiteSettingInternal(
       const ContentSettingsPattern& primary_pattern,
@@ -86,6 +92,11 @@ class BravePrefProvider : public PrefProvider,
 
   std::map<bool /* is_incognito */, std::vector<Rule>> cookie_rules_;
   std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_rules_;
+  // All ContentSettingsType::BRAVE_COOKIES rules and whether each of them is
+  // currently active, i.e. not overridden by a shields down rule.
+  std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_pref_rules_;
+  std::map<bool /* is_incognito */, std::vector<bool>>
+      brave_cookie_rules_active_;
 
   bool initialized_;
   bool store_last_modified_;
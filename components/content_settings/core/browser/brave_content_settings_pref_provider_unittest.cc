@@ -4,10 +4,14 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <memory>
+#include <string>
 #include <utility>
 
+#include "base/logging.h"
 #include "base/macros.h"
 #include "base/optional.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -524,4 +528,105 @@ TEST_F(BravePrefProviderTest, TestShieldsSettingsMigrationFromUnknownSettings) {
   provider.ShutdownOnUIThread();
 }
 
+TEST_F(BravePrefProviderTest, ShieldsDownOverridesCookieRulesOfItsSite) {
+  BravePrefProvider provider(testing_profile()->GetPrefs(),
+                             false /* incognito */,
+                             true /* store_last_modified */,
+                             false /* restore_session */);
+
+  const GURL site_url("https://sub.site.com");
+  const GURL other_url("https://other.com");
+  auto get_cookie_setting = [&provider](const GURL& url) {
+    return TestUtils::GetContentSetting(&provider, GURL("https://a.com"), url,
+                                        ContentSettingsType::COOKIES, false);
+  };
+
+  for (const auto* pattern : {"[*.]site.com", "[*.]other.com"}) {
+    provider.SetWebsiteSetting(ContentSettingsPattern::FromString(pattern),
+                               ContentSettingsPattern::Wildcard(),
+                               ContentSettingsType::BRAVE_COOKIES,
+                               ContentSettingToValue(CONTENT_SETTING_BLOCK),
+                               {});
+  }
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(site_url));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(other_url));
+
+  // Shields down for the site replaces its cookie rule with an allow rule.
+  provider.SetWebsiteSetting(ContentSettingsPattern::FromString("[*.]site.com"),
+                             ContentSettingsPattern::Wildcard(),
+                             ContentSettingsType::BRAVE_SHIELDS,
+                             ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  EXPECT_EQ(CONTENT_SETTING_ALLOW, get_cookie_setting(site_url));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(other_url));
+
+  // A subdomain pattern does not cover the cookie rule of its parent domain.
+  provider.SetWebsiteSetting(
+      ContentSettingsPattern::FromString("[*.]sub.other.com"),
+      ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_SHIELDS,
+      ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(other_url));
+
+  // Shields back up restores the cookie rule.
+  provider.SetWebsiteSetting(ContentSettingsPattern::FromString("[*.]site.com"),
+                             ContentSettingsPattern::Wildcard(),
+                             ContentSettingsType::BRAVE_SHIELDS,
+                             ContentSettingToValue(CONTENT_SETTING_ALLOW), {});
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(site_url));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(other_url));
+
+  provider.ShutdownOnUIThread();
+}
+
+TEST_F(BravePrefProviderTest, DISABLED_UpdateCookieRulesBenchmark) {
+  PrefService* pref_service = testing_profile()->GetPrefs();
+  const std::string cookies_pref_path = GetShieldsSettingUserPrefsPath(
+      GetShieldsContentTypeName(ContentSettingsType::BRAVE_COOKIES));
+  const std::string shields_pref_path = GetShieldsSettingUserPrefsPath(
+      GetShieldsContentTypeName(ContentSettingsType::BRAVE_SHIELDS));
+
+  for (const int count : {10, 100, 1000, 10000}) {
+    // |count| cookie exceptions and as many shields exceptions, half of them
+    // for the same sites
+    for (const auto& pref_path : {cookies_pref_path, shields_pref_path}) {
+      const int offset = pref_path == cookies_pref_path ? 0 : count / 2;
+      prefs::ScopedDictionaryPrefUpdate update(pref_service, pref_path);
+      std::unique_ptr<prefs::DictionaryValueUpdate> dictionary = update.Get();
+      for (int i = offset; i < offset + count; ++i) {
+        std::unique_ptr<prefs::DictionaryValueUpdate> settings_dict =
+            dictionary->SetDictionaryWithoutPathExpansion(
+                "[*.]site" + base::NumberToString(i) + ".com,*",
+                std::make_unique<base::DictionaryValue>());
+        settings_dict->SetInteger(kSettingPath, CONTENT_SETTING_ALLOW);
+      }
+    }
+
+    BravePrefProvider provider(pref_service, false /* incognito */,
+                               true /* store_last_modified */,
+                               false /* restore_session */);
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    provider.SetWebsiteSetting(
+        ContentSettingsPattern::FromString("[*.]site0.com"),
+        ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_SHIELDS,
+        ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+    LOG(INFO) << "Toggled shields with " << count << " cookie and shields "
+        << "exceptions in "
+        << (base::TimeTicks::Now() - start).InMillisecondsF() << "ms";
+
+    // Cookie changes still match every cookie rule against the shield rules
+    start = base::TimeTicks::Now();
+    provider.SetWebsiteSetting(
+        ContentSettingsPattern::FromString("[*.]site1.com"),
+        ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_COOKIES,
+        ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+    LOG(INFO) << "Changed a cookie setting with " << count << " cookie and "
+        << "shields exceptions in "
+        << (base::TimeTicks::Now() - start).InMillisecondsF() << "ms";
+
+    provider.ShutdownOnUIThread();
+    pref_service->ClearPref(cookies_pref_path);
+    pref_service->ClearPref(shields_pref_path);
+  }
+}
+
 }  //  namespace content_settings
@@ -13,6 +13,7 @@
 #include "base/callback_helpers.h"
 #include "base/feature_list.h"
 #include "base/stl_util.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/common/brave_shield_utils.h"
@@ -52,21 +53,34 @@ GURL GetOriginOrURL(const blink::WebFrame* frame) {
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
+// Returns |host| and all of its parent domains, followed by the empty host of
+// patterns matching all hosts. These are the only hosts a pattern can have to
+// match a url with |host|.
+std::vector<std::string> GetHostAndParentDomains(const std::string& host) {
+  std::vector<std::string> hosts;
+  base::StringPiece remaining(host);
+  while (!remaining.empty()) {
+    hosts.push_back(remaining.as_string());
+    const size_t dot = remaining.find('.');
+    if (dot == base::StringPiece::npos)
       break;
-    }
+    remaining.remove_prefix(dot + 1);
   }
+  hosts.emplace_back();
+  return hosts;
+}
 
-  return setting == CONTENT_SETTING_BLOCK;
+BraveFarblingLevel GetFarblingLevelForSetting(ContentSetting setting) {
+  if (setting == CONTENT_SETTING_BLOCK) {
+    VLOG(1) << "farbling level MAXIMUM";
+    return BraveFarblingLevel::MAXIMUM;
+  } else if (setting == CONTENT_SETTING_ALLOW) {
+    VLOG(1) << "farbling level OFF";
+    return BraveFarblingLevel::OFF;
+  } else {
+    VLOG(1) << "farbling level BALANCED";
+    return BraveFarblingLevel::BALANCED;
+  }
 }
 
 }  // namespace
@@ -103,6 +117,10 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  // Shields settings changes are followed by a reload, so this also picks up
+  // rules that were updated in place. The caches are dropped on the next
+  // lookup.
+  cached_rules_ = nullptr;
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -237,12 +255,88 @@ void BraveContentSettingsAgentImpl::DidBlockFingerprinting(
   Send(new BraveViewHostMsg_FingerprintingBlocked(routing_id(), details));
 }
 
+void BraveContentSettingsAgentImpl::MaybeResetShieldsCache() {
+  // The rules are shared by all frames and overwritten in place when the
+  // browser delivers new ones, so there is no per-frame notification. Every
+  // delivered set of rules has its own generation, so compare that instead.
+  const uint64_t rules_generation =
+      content_setting_rules_ ? content_setting_rules_->brave_rules_generation
+                             : 0;
+  if (cached_rules_ == content_setting_rules_ &&
+      cached_rules_generation_ == rules_generation) {
+    return;
+  }
+
+  cached_shields_down_.clear();
+  cached_farbling_levels_.clear();
+  shields_rule_indices_.clear();
+  cached_rules_ = content_setting_rules_;
+  cached_rules_generation_ = rules_generation;
+  if (!content_setting_rules_)
+    return;
+
+  const auto& rules = content_setting_rules_->brave_shields_rules;
+  for (size_t i = 0; i < rules.size(); ++i)
+    shields_rule_indices_[rules[i].primary_pattern.GetHost()].push_back(i);
+}
+
+ContentSetting BraveContentSettingsAgentImpl::GetBraveShieldsSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  DCHECK(content_setting_rules_);
+  MaybeResetShieldsCache();
+
+  // Only rules for the primary host, its parent domains and all hosts can
+  // match, and the first matching rule in the list takes precedence.
+  const auto& rules = content_setting_rules_->brave_shields_rules;
+  size_t match = rules.size();
+  for (const auto& host : GetHostAndParentDomains(primary_url.host())) {
+    auto it = shields_rule_indices_.find(host);
+    if (it == shields_rule_indices_.end())
+      continue;
+
+    // Indices are ascending, so only rules before the best match so far can
+    // take precedence over it.
+    for (size_t i : it->second) {
+      if (i >= match)
+        break;
+
+      if (rules[i].primary_pattern.Matches(primary_url) &&
+          rules[i].secondary_pattern.Matches(secondary_url)) {
+        match = i;
+        break;
+      }
+    }
+  }
+
+  return match < rules.size() ? rules[match].GetContentSetting()
+                              : CONTENT_SETTING_DEFAULT;
+}
+
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
-  return !content_setting_rules_ ||
-         ::content_settings::IsBraveShieldsDown(
-             frame, secondary_url, content_setting_rules_->brave_shields_rules);
+  if (!content_setting_rules_)
+    return true;
+
+  // Patterns for http(s) only look at the scheme, host and port, so every
+  // script from the same origin shares one entry. Other URLs, e.g. data:
+  // URLs, are matched directly.
+  if (!secondary_url.SchemeIsHTTPOrHTTPS()) {
+    return GetBraveShieldsSetting(GetOriginOrURL(frame), secondary_url) ==
+           CONTENT_SETTING_BLOCK;
+  }
+
+  MaybeResetShieldsCache();
+  ShieldsCacheKey key(GetOriginOrURL(frame), secondary_url.GetOrigin());
+  const auto cached = cached_shields_down_.find(key);
+  if (cached != cached_shields_down_.end())
+    return cached->second;
+
+  const bool shields_down =
+      GetBraveShieldsSetting(key.first, key.second) == CONTENT_SETTING_BLOCK;
+  cached_shields_down_.emplace(std::move(key), shields_down);
+  return shields_down;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
@@ -263,25 +357,26 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    if (IsBraveShieldsDown(frame,
-                           url::Origin(frame->GetSecurityOrigin()).GetURL())) {
+    MaybeResetShieldsCache();
+    const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
+    ShieldsCacheKey key(GetOriginOrURL(frame), secondary_url);
+    const auto cached = cached_farbling_levels_.find(key);
+    if (cached != cached_farbling_levels_.end())
+      return cached->second;
+
+    if (IsBraveShieldsDown(frame, secondary_url)) {
       setting = CONTENT_SETTING_ALLOW;
     } else {
       setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules, GetOriginOrURL(frame));
+          content_setting_rules_->fingerprinting_rules, key.first);
     }
-  }
 
-  if (setting == CONTENT_SETTING_BLOCK) {
-    VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
-  } else if (setting == CONTENT_SETTING_ALLOW) {
-    VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
-  } else {
-    VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
+    const BraveFarblingLevel level = GetFarblingLevelForSetting(setting);
+    cached_farbling_levels_.emplace(std::move(key), level);
+    return level;
   }
+
+  return GetFarblingLevelForSetting(setting);
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 #define BRAVE_COMPONENTS_CONTENT_SETTINGS_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -13,6 +14,7 @@
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
+#include "base/gtest_prod_util.h"
 #include "base/strings/string16.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -57,6 +59,14 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
                            AutoplayBlockedByDefault);
   FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplAutoplayBrowserTest,
                            AutoplayAllowedByDefault);
+  FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplShieldsCacheTest,
+                           LookupsFollowAddedRule);
+  FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplShieldsCacheTest,
+                           LookupsFollowFlippedRule);
+  FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplShieldsCacheTest,
+                           LookupsMatchParentDomainsInRuleOrder);
+  FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplShieldsCacheTest,
+                           DISABLED_FarblingLevelBenchmark);
 
   bool IsBraveShieldsDown(
       const blink::WebFrame* frame,
@@ -67,6 +77,14 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   void OnAllowScriptsOnce(const std::vector<std::string>& origins);
   void DidCommitProvisionalLoad(ui::PageTransition transition) override;
 
+  // Drops cached Shields lookups and reindexes the Shields rules if different
+  // content setting rules were delivered since they were computed.
+  void MaybeResetShieldsCache();
+
+  // Returns the setting of the first Shields rule matching the urls.
+  ContentSetting GetBraveShieldsSetting(const GURL& primary_url,
+                                        const GURL& secondary_url);
+
   bool IsScriptTemporilyAllowed(const GURL& script_url);
   bool AllowStorageAccessForMainFrameSync(StorageType storage_type);
 
@@ -83,6 +101,19 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   using StoragePermissionsKey = std::pair<url::Origin, StorageType>;
   base::flat_map<StoragePermissionsKey, bool> cached_storage_permissions_;
 
+  // Shields and farbling lookups walk the content setting rules and are made
+  // for every script and fingerprinting API call, so their results are cached
+  // per (primary url, secondary url) until the next commit or rules update.
+  using ShieldsCacheKey = std::pair<GURL, GURL>;
+  base::flat_map<ShieldsCacheKey, bool> cached_shields_down_;
+  base::flat_map<ShieldsCacheKey, BraveFarblingLevel> cached_farbling_levels_;
+  // Indices of the Shields rules, in ascending order, by the host of their
+  // primary pattern, so that a lookup only walks the rules for the primary
+  // host and its parent domains.
+  std::map<std::string, std::vector<size_t>> shields_rule_indices_;
+  const RendererContentSettingRules* cached_rules_ = nullptr;
+  uint64_t cached_rules_generation_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
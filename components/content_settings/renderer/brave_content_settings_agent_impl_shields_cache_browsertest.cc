@@ -0,0 +1,202 @@
+/* Copyright 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/renderer/brave_content_settings_agent_impl.h"
+
+#include <memory>
+#include <string>
+
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/render_view.h"
+#include "content/public/test/render_view_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+
+// To run the benchmark, add --gtest_also_run_disabled_tests to:
+// npm run test -- brave_browser_tests --filter=*ShieldsCacheTest.*
+
+namespace content_settings {
+namespace {
+
+// An empty pattern string stands for the wildcard pattern.
+ContentSettingPatternSource MakeRule(const std::string& primary_pattern,
+                                     const std::string& secondary_pattern,
+                                     ContentSetting setting) {
+  return ContentSettingPatternSource(
+      primary_pattern.empty()
+          ? ContentSettingsPattern::Wildcard()
+          : ContentSettingsPattern::FromString(primary_pattern),
+      secondary_pattern.empty()
+          ? ContentSettingsPattern::Wildcard()
+          : ContentSettingsPattern::FromString(secondary_pattern),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(setting)),
+      std::string(), false);
+}
+
+}  // namespace
+
+class BraveContentSettingsAgentImplShieldsCacheTest
+    : public content::RenderViewTest {
+ protected:
+  void SetUp() override {
+    RenderViewTest::SetUp();
+
+    // Unbind the ContentSettingsAgent interface that would be registered by
+    // the ContentSettingsAgentImpl created when the render frame is created.
+    view_->GetMainRenderFrame()
+        ->GetAssociatedInterfaceRegistry()
+        ->RemoveInterface(mojom::ContentSettingsAgent::Name_);
+
+    LoadHTMLWithUrlOverride("<html>Farbling</html>", "https://example.com/");
+  }
+
+  std::unique_ptr<BraveContentSettingsAgentImpl> CreateAgent() {
+    return std::make_unique<BraveContentSettingsAgentImpl>(
+        view_->GetMainRenderFrame(), false,
+        std::make_unique<ContentSettingsAgentImpl::Delegate>());
+  }
+
+  blink::WebLocalFrame* GetWebFrame() {
+    return view_->GetMainRenderFrame()->GetWebFrame();
+  }
+};
+
+TEST_F(BraveContentSettingsAgentImplShieldsCacheTest, LookupsFollowAddedRule) {
+  RendererContentSettingRules content_setting_rules;
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule(std::string(), std::string(), CONTENT_SETTING_ALLOW));
+  content_setting_rules.fingerprinting_rules.push_back(
+      MakeRule(std::string(), std::string(), CONTENT_SETTING_BLOCK));
+
+  auto agent = CreateAgent();
+  agent->SetContentSettingRules(&content_setting_rules);
+  EXPECT_EQ(BraveFarblingLevel::MAXIMUM, agent->GetBraveFarblingLevel());
+  // Served from the cache.
+  EXPECT_EQ(BraveFarblingLevel::MAXIMUM, agent->GetBraveFarblingLevel());
+  EXPECT_FALSE(agent->IsBraveShieldsDown(
+      GetWebFrame(), GURL("https://cdn.example.net/a.js")));
+
+  // Delivering rules which take Shields down for the site overwrites the
+  // shared rules in place, as ChromeRenderThreadObserver does.
+  RendererContentSettingRules updated_rules;
+  updated_rules.brave_shields_rules.push_back(
+      MakeRule("https://example.com", std::string(), CONTENT_SETTING_BLOCK));
+  updated_rules.brave_shields_rules.push_back(
+      MakeRule(std::string(), std::string(), CONTENT_SETTING_ALLOW));
+  updated_rules.fingerprinting_rules =
+      content_setting_rules.fingerprinting_rules;
+  content_setting_rules = updated_rules;
+
+  EXPECT_EQ(BraveFarblingLevel::OFF, agent->GetBraveFarblingLevel());
+  EXPECT_TRUE(agent->IsBraveShieldsDown(
+      GetWebFrame(), GURL("https://cdn.example.net/a.js")));
+}
+
+TEST_F(BraveContentSettingsAgentImplShieldsCacheTest,
+       LookupsFollowFlippedRule) {
+  RendererContentSettingRules content_setting_rules;
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule("https://example.com", std::string(), CONTENT_SETTING_ALLOW));
+  content_setting_rules.fingerprinting_rules.push_back(
+      MakeRule(std::string(), std::string(), CONTENT_SETTING_BLOCK));
+
+  auto agent = CreateAgent();
+  agent->SetContentSettingRules(&content_setting_rules);
+  EXPECT_EQ(BraveFarblingLevel::MAXIMUM, agent->GetBraveFarblingLevel());
+  EXPECT_FALSE(agent->IsBraveShieldsDown(
+      GetWebFrame(), GURL("https://cdn.example.net/a.js")));
+
+  // The same rule flipped to taking Shields down. The rules object and the
+  // number of rules stay the same.
+  RendererContentSettingRules updated_rules;
+  updated_rules.brave_shields_rules.push_back(
+      MakeRule("https://example.com", std::string(), CONTENT_SETTING_BLOCK));
+  updated_rules.fingerprinting_rules =
+      content_setting_rules.fingerprinting_rules;
+  content_setting_rules = updated_rules;
+
+  EXPECT_EQ(BraveFarblingLevel::OFF, agent->GetBraveFarblingLevel());
+  EXPECT_TRUE(agent->IsBraveShieldsDown(
+      GetWebFrame(), GURL("https://cdn.example.net/a.js")));
+}
+
+TEST_F(BraveContentSettingsAgentImplShieldsCacheTest,
+       LookupsMatchParentDomainsInRuleOrder) {
+  LoadHTMLWithUrlOverride("<html>Farbling</html>", "https://a.example.com/");
+
+  RendererContentSettingRules content_setting_rules;
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule("https://other.com", std::string(), CONTENT_SETTING_BLOCK));
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule("[*.]example.com", "https://cdn.example.net",
+               CONTENT_SETTING_BLOCK));
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule(std::string(), std::string(), CONTENT_SETTING_ALLOW));
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule("https://a.example.com", std::string(), CONTENT_SETTING_BLOCK));
+
+  auto agent = CreateAgent();
+  agent->SetContentSettingRules(&content_setting_rules);
+  // Matched by the rule for the parent domain.
+  EXPECT_TRUE(agent->IsBraveShieldsDown(
+      GetWebFrame(), GURL("https://cdn.example.net/a.js")));
+  // The wildcard rule comes before the rule for the host itself.
+  EXPECT_FALSE(agent->IsBraveShieldsDown(
+      GetWebFrame(), GURL("https://cdn.example.org/a.js")));
+  EXPECT_FALSE(
+      agent->IsBraveShieldsDown(GetWebFrame(), GURL("data:text/javascript,")));
+}
+
+TEST_F(BraveContentSettingsAgentImplShieldsCacheTest,
+       DISABLED_FarblingLevelBenchmark) {
+  // A profile with many per-site exceptions.
+  constexpr int kSites = 1000;
+  RendererContentSettingRules content_setting_rules;
+  for (int i = 0; i < kSites; ++i) {
+    const std::string site = base::StringPrintf("https://site%d.com", i);
+    content_setting_rules.brave_shields_rules.push_back(
+        MakeRule(site, std::string(), CONTENT_SETTING_BLOCK));
+    content_setting_rules.fingerprinting_rules.push_back(
+        MakeRule(site, std::string(), CONTENT_SETTING_ALLOW));
+  }
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule(std::string(), std::string(), CONTENT_SETTING_ALLOW));
+  content_setting_rules.fingerprinting_rules.push_back(
+      MakeRule(std::string(), "https://balanced", CONTENT_SETTING_BLOCK));
+
+  auto agent = CreateAgent();
+  agent->SetContentSettingRules(&content_setting_rules);
+  blink::WebLocalFrame* frame = GetWebFrame();
+
+  constexpr int kFarblingQueries = 100000;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kFarblingQueries; ++i)
+    EXPECT_EQ(BraveFarblingLevel::BALANCED, agent->GetBraveFarblingLevel());
+  base::TimeDelta farbling_elapsed = base::TimeTicks::Now() - start;
+
+  constexpr int kScripts = 10000;
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < kScripts; ++i) {
+    EXPECT_FALSE(agent->IsBraveShieldsDown(
+        frame, GURL(base::StringPrintf("https://cdn%d.example.net/%d.js",
+                                       i % 50, i))));
+  }
+  base::TimeDelta scripts_elapsed = base::TimeTicks::Now() - start;
+
+  LOG(INFO) << kFarblingQueries << " farbling queries against " << kSites
+            << " site rules: " << farbling_elapsed.InMicroseconds() << "us";
+  LOG(INFO) << kScripts << " script checks: "
+            << scripts_elapsed.InMicroseconds() << "us";
+}
+
+}  // namespace content_settings
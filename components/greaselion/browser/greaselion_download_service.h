@@ -102,6 +102,9 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   ~GreaselionDownloadService() override;
 
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
+  // Incremented every time the rules are reloaded, so consumers can tell
+  // whether rules they hold on to are still current.
+  int rules_version() const { return rules_version_; }
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
   // implementation of LocalDataFilesObserver
@@ -129,6 +132,7 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
 
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
+  int rules_version_ = 0;
   base::FilePath resource_dir_;
   bool is_dev_mode_ = false;
   scoped_refptr<base::SequencedTaskRunner> dev_mode_task_runner_;
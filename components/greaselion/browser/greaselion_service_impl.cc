@@ -6,6 +6,7 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -238,6 +239,10 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     update_pending_ = true;
     return;
   }
+  // Most feature changes don't affect which rules match. Reinstalling every
+  // extension in that case would only churn the content scripts.
+  if (InstalledRulesAreCurrent(GetMatchingRules()))
+    return;
   update_in_progress_ = true;
   if (greaselion_extensions_.empty()) {
     // No Greaselion extensions are currently installed, so we can move on to
@@ -259,36 +264,48 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
   }
 }
 
-void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
-  DCHECK(update_in_progress_);
-  all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
+std::vector<GreaselionRule*> GreaselionServiceImpl::GetMatchingRules() {
+  std::vector<GreaselionRule*> matching_rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
     if (rule->Matches(state_, browser_version_) &&
         rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+      matching_rules.push_back(rule.get());
     }
   }
+  return matching_rules;
+}
+
+bool GreaselionServiceImpl::InstalledRulesAreCurrent(
+    const std::vector<GreaselionRule*>& rules) {
+  // Rule pointers can only be compared while the rules haven't been
+  // reloaded. Failed installs are always retried.
+  return installed_rules_version_ == download_service_->rules_version() &&
+         all_rules_installed_successfully_ && installed_rules_ == rules;
+}
+
+void GreaselionServiceImpl::CreateAndInstallExtensions() {
+  DCHECK(greaselion_extensions_.empty());
+  DCHECK(update_in_progress_);
+  all_rules_installed_successfully_ = true;
+  // Evaluate the preconditions once for this state.
+  installed_rules_ = GetMatchingRules();
+  installed_rules_version_ = download_service_->rules_version();
+  pending_installs_ = static_cast<int>(installed_rules_.size());
   if (!pending_installs_) {
     // no rules match, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule.get(), install_directory_, &extension_dirs_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  for (GreaselionRule* rule : installed_rules_) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner, rule,
+                       install_directory_, &extension_dirs_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr()));
   }
 }
 
@@ -355,10 +372,12 @@ void GreaselionServiceImpl::RemoveObserver(Observer* observer) {
 void GreaselionServiceImpl::MaybeNotifyObservers() {
   if (!pending_installs_) {
     update_in_progress_ = false;
-    if (update_pending_) {
+    // A pending update that wouldn't change anything finishes this one.
+    if (update_pending_ && !InstalledRulesAreCurrent(GetMatchingRules())) {
       update_pending_ = false;
       UpdateInstalledExtensions();
     } else {
+      update_pending_ = false;
       for (Observer& observer : observers_)
         observer.OnExtensionsReady(this, all_rules_installed_successfully_);
     }
@@ -368,6 +387,8 @@ void GreaselionServiceImpl::MaybeNotifyObservers() {
 void GreaselionServiceImpl::SetFeatureEnabled(GreaselionFeature feature,
                                               bool enabled) {
   DCHECK(feature >= 0 && feature < LAST_FEATURE);
+  if (state_[feature] == enabled)
+    return;
   state_[feature] = enabled;
   UpdateInstalledExtensions();
 }
@@ -34,6 +34,7 @@ class ExtensionSystem;
 namespace greaselion {
 
 class GreaselionDownloadService;
+class GreaselionRule;
 
 class GreaselionServiceImpl : public GreaselionService {
  public:
@@ -63,6 +64,8 @@ class GreaselionServiceImpl : public GreaselionService {
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  std::vector<GreaselionRule*> GetMatchingRules();
+  bool InstalledRulesAreCurrent(const std::vector<GreaselionRule*>& rules);
   void CreateAndInstallExtensions();
   void PostConvert(scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
@@ -81,6 +84,10 @@ class GreaselionServiceImpl : public GreaselionService {
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
+  // The rules the installed extensions were created from, and the version of
+  // the download service's rules they belong to.
+  std::vector<GreaselionRule*> installed_rules_;
+  int installed_rules_version_ = -1;
   std::vector<base::ScopedTempDir> extension_dirs_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
@@ -5,6 +5,8 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <vector>
+
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
@@ -51,18 +53,41 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
-  LogEntry& entry = log_[histogram_name];
-  entry.value = value;
-  if (!entry.sent) {
-    DCHECK(entry.sent_timestamp.is_null());
-    unsent_entries_.insert(histogram_name);
+  UpdateValues({{histogram_name, value}});
+}
+
+void BraveP3ALogStore::UpdateValues(
+    const base::flat_map<std::string, uint64_t>& values) {
+  std::vector<std::string> changed_entries;
+  for (const auto& pair : values) {
+    const std::string& histogram_name = pair.first;
+    auto iter = log_.find(histogram_name);
+    if (iter != log_.end() && iter->second.value == pair.second) {
+      // Nothing new to persist.
+      continue;
+    }
+
+    LogEntry& entry = log_[histogram_name];
+    entry.value = pair.second;
+    if (!entry.sent) {
+      DCHECK(entry.sent_timestamp.is_null());
+      unsent_entries_.insert(histogram_name);
+    }
+    changed_entries.push_back(histogram_name);
   }
 
-  // Update the persistent value.
+  if (changed_entries.empty()) {
+    return;
+  }
+
+  // Update the persistent values.
   DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  for (const std::string& histogram_name : changed_entries) {
+    const LogEntry& entry = log_[histogram_name];
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  }
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
@@ -19,7 +19,8 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists changed ones in prefs on the
+// fly.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -44,6 +45,9 @@ class BraveP3ALogStore : public metrics::LogStore {
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
   void UpdateValue(const std::string& histogram_name, uint64_t value);
+  // Same as |UpdateValue| for several metrics, persisted with a single prefs
+  // update. Unchanged values are not persisted again.
+  void UpdateValues(const base::flat_map<std::string, uint64_t>& values);
   // Removes and also unstages the metric value if it is known and/or staged.
   void RemoveValueIfExists(const std::string& histogram_name);
   // Marks all saved values as unsent.
@@ -0,0 +1,120 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/strings/string_number_conversions.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3ALogStoreTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) override {
+    return histogram_name.as_string() + ":" + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = CreateLogStore();
+
+    pref_change_registrar_.Init(&local_state_);
+    pref_change_registrar_.Add(
+        kPrefName, base::BindRepeating(&BraveP3ALogStoreTest::OnLogsChanged,
+                                       base::Unretained(this)));
+  }
+
+  std::unique_ptr<BraveP3ALogStore> CreateLogStore() {
+    auto log_store =
+        std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store->LoadPersistedUnsentLogs();
+    return log_store;
+  }
+
+  void OnLogsChanged() { logs_changed_count_++; }
+
+  TestDelegate delegate_;
+  TestingPrefServiceSimple local_state_;
+  PrefChangeRegistrar pref_change_registrar_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+  int logs_changed_count_ = 0;
+};
+
+TEST_F(BraveP3ALogStoreTest, UnchangedValuesDoNotDirtyPrefs) {
+  log_store_->UpdateValues({{"Brave.P3A.A", 1}, {"Brave.P3A.B", 2}});
+  EXPECT_EQ(logs_changed_count_, 1);
+
+  log_store_->UpdateValues({{"Brave.P3A.A", 1}, {"Brave.P3A.B", 2}});
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  EXPECT_EQ(logs_changed_count_, 1);
+
+  // Only the changed value is written, still with a single update.
+  log_store_->UpdateValues({{"Brave.P3A.A", 1}, {"Brave.P3A.B", 3}});
+  EXPECT_EQ(logs_changed_count_, 2);
+}
+
+TEST_F(BraveP3ALogStoreTest, BatchedValuesArePersisted) {
+  log_store_->UpdateValues({{"Brave.P3A.A", 1}, {"Brave.P3A.B", 2}});
+  log_store_->UpdateValues({{"Brave.P3A.B", 3}, {"Brave.P3A.C", 4}});
+
+  // A fresh store only sees what reached the prefs.
+  log_store_ = CreateLogStore();
+  ASSERT_TRUE(log_store_->has_unsent_logs());
+
+  base::flat_map<std::string, std::string> staged_logs;
+  while (log_store_->has_unsent_logs()) {
+    log_store_->StageNextLog();
+    const std::string log = log_store_->staged_log();
+    staged_logs[log.substr(0, log.find(':'))] = log;
+    log_store_->DiscardStagedLog();
+  }
+
+  EXPECT_EQ(staged_logs.size(), 3u);
+  EXPECT_EQ(staged_logs["Brave.P3A.A"], "Brave.P3A.A:1");
+  EXPECT_EQ(staged_logs["Brave.P3A.B"], "Brave.P3A.B:3");
+  EXPECT_EQ(staged_logs["Brave.P3A.C"], "Brave.P3A.C:4");
+}
+
+TEST_F(BraveP3ALogStoreTest, ChangedValueOfSentEntryKeepsSentState) {
+  log_store_->UpdateValue("Brave.P3A.A", 1);
+  log_store_->StageNextLog();
+  log_store_->DiscardStagedLog();
+  ASSERT_FALSE(log_store_->has_unsent_logs());
+
+  // A new value does not requeue an entry that was already sent for the
+  // current rotation.
+  log_store_->UpdateValues({{"Brave.P3A.A", 2}});
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+
+  log_store_->ResetUploadStamps();
+  ASSERT_TRUE(log_store_->has_unsent_logs());
+  log_store_->StageNextLog();
+  EXPECT_EQ(log_store_->staged_log(), "Brave.P3A.A:2");
+}
+
+}  // namespace brave
@@ -56,6 +56,10 @@ constexpr char kP2AServerUrl[] = "https://p2a.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+// Histogram updates are coalesced for this long before they are handed to the
+// UI thread as a single batch.
+constexpr int64_t kStagedHistogramsFlushDelaySeconds = 1;
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -240,9 +244,7 @@ void BraveP3AService::Init(
   log_store_.reset(new BraveP3ALogStore(this, local_state_));
   log_store_->LoadPersistedUnsentLogs();
   // Store values that were recorded between calling constructor and |Init()|.
-  for (const auto& entry : histogram_values_) {
-    HandleHistogramChange(entry.first.as_string(), entry.second);
-  }
+  HandleHistogramChanges(histogram_values_);
   histogram_values_ = {};
   // Do rotation if needed.
   const base::Time last_rotation =
@@ -408,12 +410,7 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
   if (IsSuspendedMetric(histogram_name, sample)) {
-    base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                   base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this,
-                                  histogram_name,
-                                  kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
+    StageHistogramChange(histogram_name, kSuspendedMetricBucket);
     return;
   }
 
@@ -442,31 +439,58 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
     bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
   }
 
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+  StageHistogramChange(histogram_name, bucket);
+}
+
+void BraveP3AService::StageHistogramChange(const char* histogram_name,
+                                           size_t bucket) {
+  {
+    base::AutoLock lock(staged_histograms_lock_);
+    // Only the latest bucket matters, earlier ones are simply overwritten.
+    staged_histograms_[histogram_name] = bucket;
+    if (staged_histograms_flush_scheduled_) {
+      return;
+    }
+    staged_histograms_flush_scheduled_ = true;
+  }
+
+  base::PostDelayedTask(
+      FROM_HERE, {content::BrowserThread::UI},
+      base::BindOnce(&BraveP3AService::FlushStagedHistogramsOnUI, this),
+      base::TimeDelta::FromSeconds(kStagedHistogramsFlushDelaySeconds));
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+void BraveP3AService::FlushStagedHistogramsOnUI() {
+  base::flat_map<std::string, size_t> staged_histograms;
+  {
+    base::AutoLock lock(staged_histograms_lock_);
+    staged_histograms.swap(staged_histograms_);
+    staged_histograms_flush_scheduled_ = false;
+  }
+
+  VLOG(2) << "BraveP3AService::FlushStagedHistogramsOnUI: "
+          << staged_histograms.size() << " histograms changed";
   if (!initialized_) {
     // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
+    for (const auto& entry : staged_histograms) {
+      histogram_values_[entry.first] = entry.second;
+    }
   } else {
-    HandleHistogramChange(histogram_name, bucket);
+    HandleHistogramChanges(staged_histograms);
   }
 }
 
-void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
-                                            size_t bucket) {
-  if (IsSuspendedMetric(histogram_name, bucket)) {
-    log_store_->RemoveValueIfExists(histogram_name.as_string());
-    return;
+void BraveP3AService::HandleHistogramChanges(
+    const base::flat_map<std::string, size_t>& buckets) {
+  base::flat_map<std::string, uint64_t> values;
+  for (const auto& entry : buckets) {
+    if (IsSuspendedMetric(entry.first, entry.second)) {
+      log_store_->RemoveValueIfExists(entry.first);
+      continue;
+    }
+    values[entry.first] = entry.second;
   }
-  log_store_->UpdateValue(histogram_name.as_string(), bucket);
+  log_store_->UpdateValues(values);
 }
 
 void BraveP3AService::OnLogUploadComplete(int response_code,
@@ -10,8 +10,10 @@
 #include <string>
 
 #include "base/containers/flat_map.h"
+#include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
+#include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
@@ -56,6 +58,7 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
  private:
   friend class base::RefCountedThreadSafe<BraveP3AService>;
+  FRIEND_TEST_ALL_PREFIXES(BraveP3AServiceTest, StagedHistogramsLandAfterFlush);
   ~BraveP3AService() override;
 
   void MaybeOverrideSettingsFromCommandLine();
@@ -68,17 +71,20 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method stages the latest bucket of each
+  // histogram and periodically hands them over to UI thread.
   void OnHistogramChanged(const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  // May be called on any thread.
+  void StageHistogramChange(const char* histogram_name, size_t bucket);
 
-  // Updates or removes a metric from the log.
-  void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
+  void FlushStagedHistogramsOnUI();
+
+  // Updates or removes metrics from the log.
+  void HandleHistogramChanges(
+      const base::flat_map<std::string, size_t>& buckets);
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
@@ -107,7 +113,13 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
   // Used to store histogram values that are produced between constructing
   // the service and its initialization.
-  base::flat_map<base::StringPiece, size_t> histogram_values_;
+  base::flat_map<std::string, size_t> histogram_values_;
+
+  // Latest buckets recorded on any thread that are not yet handled on UI.
+  // Both are guarded by |staged_histograms_lock_|.
+  base::Lock staged_histograms_lock_;
+  base::flat_map<std::string, size_t> staged_histograms_;
+  bool staged_histograms_flush_scheduled_ = false;
 
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
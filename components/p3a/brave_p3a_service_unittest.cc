@@ -0,0 +1,44 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_service.h"
+
+#include "base/time/time.h"
+#include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3AServiceTest.*
+
+namespace brave {
+
+TEST(BraveP3AServiceTest, StagedHistogramsLandAfterFlush) {
+  content::BrowserTaskEnvironment task_environment(
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME);
+  TestingPrefServiceSimple local_state;
+  BraveP3AService::RegisterPrefs(local_state.registry(), false);
+  auto service = base::MakeRefCounted<BraveP3AService>(&local_state);
+
+  // Only the latest bucket of each histogram is kept until the flush.
+  service->StageHistogramChange("Brave.P3A.A", 1);
+  service->StageHistogramChange("Brave.P3A.A", 2);
+  service->StageHistogramChange("Brave.P3A.B", 3);
+
+  task_environment.FastForwardBy(base::TimeDelta::FromMilliseconds(999));
+  EXPECT_TRUE(service->histogram_values_.empty());
+
+  task_environment.FastForwardBy(base::TimeDelta::FromMilliseconds(1));
+  ASSERT_EQ(service->histogram_values_.size(), 2u);
+  EXPECT_EQ(service->histogram_values_["Brave.P3A.A"], 2u);
+  EXPECT_EQ(service->histogram_values_["Brave.P3A.B"], 3u);
+
+  // A change staged after the flush schedules another one.
+  service->StageHistogramChange("Brave.P3A.A", 4);
+  task_environment.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(service->histogram_values_["Brave.P3A.A"], 4u);
+  EXPECT_EQ(service->histogram_values_["Brave.P3A.B"], 3u);
+}
+
+}  // namespace brave
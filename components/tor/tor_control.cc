@@ -306,7 +306,10 @@ bool TorControl::EatControlCookie(std::vector<uint8_t>& cookie,
 
   // Success!
   cookie.assign(buf, buf + nread);
-  mtime = info.last_accessed;
+  // Use the modification time, like EatControlPort: the access time
+  // is bumped by our own reads, which would make a stale cookie look
+  // fresh and cost a failed AUTHENTICATE round trip.
+  mtime = info.last_modified;
   VLOG(3) << "Control cookie " << base::HexEncode(buf, nread) << ", mtime "
           << mtime;
   return true;
@@ -491,18 +494,41 @@ void TorControl::Authenticated(bool error,
                                const std::string& status,
                                const std::string& reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  if (!error) {
-    if (status != "250" || reply != "OK")
-      error = true;
-  }
   if (error) {
+    // The connection failed; Error() is already cleaning up.
     VLOG(0) << "tor: control authentication failed";
     return;
   }
+  if (status != "250" || reply != "OK") {
+    // Tor rejected the cookie, most likely one left over from a
+    // previous run.  Drop the connection and go back to waiting for
+    // tor to write a fresh one, rather than sitting on a useless
+    // connection.  This must happen after the current reply has been
+    // consumed, so do it in a task.
+    VLOG(0) << "tor: control authentication rejected";
+    io_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&TorControl::AuthenticationFailed,
+                                  base::Unretained(this)));
+    return;
+  }
   VLOG(2) << "tor: control connection ready";
   NotifyTorControlReady();
 }
 
+// AuthenticationFailed()
+//
+//      Close a connection that tor refused to authenticate and let the
+//      watcher decide when to try again.
+//
+void TorControl::AuthenticationFailed() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  if (!socket_)
+    return;
+  Disconnect();
+  watch_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&TorControl::PollDone, base::Unretained(this)));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Event subscriptions
 
@@ -765,7 +791,9 @@ void TorControl::GetSOCKSListenersDone(
 
 // StartWrite()
 //
-//      Pick a write off the queue and start an I/O buffer for it.
+//      Take every write off the queue and start a single I/O buffer
+//      for all of them, so that commands issued in a burst go out in
+//      one socket write rather than one write per command.
 //
 //      Caller must ensure writing_ is true.
 //
@@ -774,9 +802,14 @@ void TorControl::StartWrite() {
   DCHECK(writing_);
   DCHECK(!writeq_.empty());
   DCHECK(!cmdq_.empty());
-  auto buf = base::MakeRefCounted<net::StringIOBuffer>(writeq_.front());
-  writeiobuf_ = base::MakeRefCounted<net::DrainableIOBuffer>(buf, buf->size());
+  std::string batch = std::move(writeq_.front());
   writeq_.pop();
+  while (!writeq_.empty()) {
+    batch += writeq_.front();
+    writeq_.pop();
+  }
+  auto buf = base::MakeRefCounted<net::StringIOBuffer>(std::move(batch));
+  writeiobuf_ = base::MakeRefCounted<net::DrainableIOBuffer>(buf, buf->size());
 }
 
 // DoWrites()
@@ -941,47 +974,72 @@ void TorControl::ReadDone(int rv) {
     Error();
     return;
   }
-  const char* data = readiobuf_->data();
-  for (int i = 0; i < rv; i++) {
-    if (!read_cr_) {
-      // No CR yet.  Accept CR or non-LF; reject LF.
-      if (data[i] == 0x0d) {  // CR
-        read_cr_ = true;
-      } else if (data[i] == 0x0a) {  // LF
-        VLOG(1) << "tor: stray line feed";
-        Error();
-        return;
-      } else {
-        // Anything else: Just accept it and move on.
-      }
-    } else {
-      // CR seen.  Accept LF; reject all else.
-      if (data[i] == 0x0a) {  // LF
-        // CRLF seen, so we must have i >= 2.  Emit a line and advance
-        // to the next one, unless anything went wrong with the line.
-        assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
-        read_start_ = readiobuf_->offset() + i + 1;
-        read_cr_ = false;
-        if (!ReadLine(line)) {
-          reading_ = false;
-          return;
-        }
-      } else {
-        // CR seen, but not LF.  Bad.
-        VLOG(1) << "tor: stray carriage return";
-        Error();
-        return;
-      }
+  // Walk the new input a line at a time, searching for CR with memchr
+  // rather than a byte at a time, and hand each line to ReadLine() as
+  // a view into readiobuf_ without copying it.
+  const char* const buf = readiobuf_->StartOfBuffer();
+  const char* p = readiobuf_->data();
+  const char* const end = p + rv;
+  if (read_cr_) {
+    // CR seen at the end of the last read.  Accept LF; reject all else.
+    if (*p != 0x0a) {  // LF
+      VLOG(1) << "tor: stray carriage return";
+      Error();
+      return;
+    }
+    base::StringPiece line(buf + read_start_, p - 1 - (buf + read_start_));
+    read_start_ = p + 1 - buf;
+    read_cr_ = false;
+    if (!ReadLine(line)) {
+      reading_ = false;
+      return;
+    }
+    p++;
+  }
+  while (p < end) {
+    const char* cr = static_cast<const char*>(memchr(p, 0x0d, end - p));
+    const char* stop = cr ? cr : end;
+    // No LF is allowed anywhere but right after a CR.
+    if (memchr(p, 0x0a, stop - p)) {
+      VLOG(1) << "tor: stray line feed";
+      Error();
+      return;
     }
+    if (!cr)
+      break;
+    if (cr + 1 == end) {
+      // CR is the last octet of this read; wait for the LF.
+      read_cr_ = true;
+      break;
+    }
+    if (cr[1] != 0x0a) {  // LF
+      // CR seen, but not LF.  Bad.
+      VLOG(1) << "tor: stray carriage return";
+      Error();
+      return;
+    }
+    // CRLF seen.  Emit a line and advance to the next one, unless
+    // anything went wrong with the line.
+    base::StringPiece line(buf + read_start_, cr - (buf + read_start_));
+    read_start_ = cr + 2 - buf;
+    if (!ReadLine(line)) {
+      reading_ = false;
+      return;
+    }
+    p = cr + 2;
   }
 
   // If we've walked up to the end of the buffer, try shifting it to
   // the beginning to make room; if there's no more room, fail --
   // lines shouldn't be this long.
   DCHECK(rv <= readiobuf_->RemainingCapacity());
-  if (readiobuf_->RemainingCapacity() == rv) {
+  if (read_start_ == readiobuf_->offset() + rv) {
+    // Every line has been consumed, so rewind to the start of the
+    // buffer for free instead of waiting until it fills up and has to
+    // be shifted.
+    readiobuf_->set_offset(0);
+    read_start_ = 0;
+  } else if (readiobuf_->RemainingCapacity() == rv) {
     if (read_start_ == 0) {
       // Line is too long.
       VLOG(1) << "tor: control line too long";
@@ -1017,7 +1075,7 @@ void TorControl::ReadDone(int rv) {
 //      We have read a line of input; process it.  Return true on
 //      success, false on error.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -1032,9 +1090,9 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
+  base::StringPiece status = line.substr(0, 3);
   char pos = line[3];
-  std::string reply(line, 4);
+  base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
@@ -1045,11 +1103,12 @@ bool TorControl::ReadLine(const std::string& line) {
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
-        event_name = reply;
+      base::StringPiece initial;
+      std::string event_name;
+      if (sp == base::StringPiece::npos) {
+        event_name = reply.as_string();
       } else {
-        event_name = reply.substr(0, sp);
+        event_name = reply.substr(0, sp).as_string();
         initial = reply.substr(sp + 1);
       }
 
@@ -1074,7 +1133,7 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Notify the delegate of the parsed reply.  No extra
           // because there were no intermediate reply lines.
-          NotifyTorEvent(event, initial, {});
+          NotifyTorEvent(event, initial.as_string(), {});
 
           return true;
         }
@@ -1089,7 +1148,7 @@ bool TorControl::ReadLine(const std::string& line) {
                                                      : (*found).second);
           async_ = std::make_unique<Async>();
           async_->event = event;
-          async_->initial = initial;
+          async_->initial = initial.as_string();
           async_->skip = (event == TorControlEvent::INVALID);
           return true;
         }
@@ -1161,7 +1220,7 @@ bool TorControl::ReadLine(const std::string& line) {
         NotifyTorRawMid(status, reply);
         if (!cmdq_.empty()) {
           PerLineCallback& perline = cmdq_.front().first;
-          perline.Run(status, reply);
+          perline.Run(status.as_string(), reply.as_string());
         }
         return true;
       case '+':
@@ -1173,7 +1232,8 @@ bool TorControl::ReadLine(const std::string& line) {
         if (!cmdq_.empty()) {
           CmdCallback& callback = cmdq_.front().second;
           bool error = false;
-          std::move(callback).Run(error, status, reply);
+          std::move(callback).Run(error, status.as_string(),
+                                  reply.as_string());
           cmdq_.pop();
         }
         return true;
@@ -1199,6 +1259,25 @@ void TorControl::Error() {
 
   VLOG(1) << "tor: closing control on " << (running_ ? "request" : "error");
 
+  Disconnect();
+
+  // If we're still running, try watching again to start over.
+  //
+  // XXX Rate limit in case of flapping?
+  if (running_) {
+    watch_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&TorControl::Poll, base::Unretained(this)));
+  }
+}
+
+// Disconnect()
+//
+//      Fail all pending commands, clear read and write state, and close
+//      the socket.
+//
+void TorControl::Disconnect() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+
   NotifyTorClosed();
 
   // Invoke all callbacks with errors and clear read state.
@@ -1220,14 +1299,6 @@ void TorControl::Error() {
 
   // Clear the socket.
   socket_.reset();
-
-  // If we're still running, try watching again to start over.
-  //
-  // XXX Rate limit in case of flapping?
-  if (running_) {
-    watch_task_runner_->PostTask(
-        FROM_HERE, base::BindOnce(&TorControl::Poll, base::Unretained(this)));
-  }
 }
 
 void TorControl::NotifyTorControlReady() {
@@ -1287,8 +1358,8 @@ void TorControl::NotifyTorRawCmd(const std::string& cmd) {
                      delegate_->AsWeakPtr(), cmd));
 }
 
-void TorControl::NotifyTorRawAsync(const std::string& status,
-                                   const std::string& line) {
+void TorControl::NotifyTorRawAsync(base::StringPiece status,
+                                   base::StringPiece line) {
   content::GetUIThreadTaskRunner({})->PostTask(
       FROM_HERE, base::BindOnce(
                      [](base::WeakPtr<TorControl::Delegate> delegate,
@@ -1296,11 +1367,12 @@ void TorControl::NotifyTorRawAsync(const std::string& status,
                        if (delegate)
                          delegate->OnTorRawAsync(status, line);
                      },
-                     delegate_->AsWeakPtr(), status, line));
+                     delegate_->AsWeakPtr(), status.as_string(),
+                     line.as_string()));
 }
 
-void TorControl::NotifyTorRawMid(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawMid(base::StringPiece status,
+                                 base::StringPiece line) {
   content::GetUIThreadTaskRunner({})->PostTask(
       FROM_HERE, base::BindOnce(
                      [](base::WeakPtr<TorControl::Delegate> delegate,
@@ -1308,11 +1380,12 @@ void TorControl::NotifyTorRawMid(const std::string& status,
                        if (delegate)
                          delegate->OnTorRawMid(status, line);
                      },
-                     delegate_->AsWeakPtr(), status, line));
+                     delegate_->AsWeakPtr(), status.as_string(),
+                     line.as_string()));
 }
 
-void TorControl::NotifyTorRawEnd(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawEnd(base::StringPiece status,
+                                 base::StringPiece line) {
   content::GetUIThreadTaskRunner({})->PostTask(
       FROM_HERE, base::BindOnce(
                      [](base::WeakPtr<TorControl::Delegate> delegate,
@@ -1320,7 +1393,8 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
                        if (delegate)
                          delegate->OnTorRawEnd(status, line);
                      },
-                     delegate_->AsWeakPtr(), status, line));
+                     delegate_->AsWeakPtr(), status.as_string(),
+                     line.as_string()));
 }
 
 // ParseKV(string, key, value)
@@ -1330,7 +1404,7 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
 //      success, false on failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value) {
   size_t end;
@@ -1345,21 +1419,21 @@ bool TorControl::ParseKV(const std::string& string,
 //      failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value,
                          size_t* end) {
   DCHECK(key && value && end);
   // Search for `=' -- it had better be there.
-  size_t eq = string.find("=");
-  if (eq == std::string::npos)
+  size_t eq = string.find('=');
+  if (eq == base::StringPiece::npos)
     return false;
   size_t vstart = eq + 1;
 
   // If we're at the end of the string, value is empt.
   if (vstart == string.size()) {
-    *key = string.substr(0, eq);
-    *value = "";
+    string.substr(0, eq).CopyToString(key);
+    value->clear();
     *end = string.size();
     return true;
   }
@@ -1368,7 +1442,7 @@ bool TorControl::ParseKV(const std::string& string,
   if (string[vstart] != '"') {
     // Not quoted.  Check for a delimiter.
     size_t i, vend = string.size();
-    if ((i = string.find(" ", vstart)) != std::string::npos) {
+    if ((i = string.find(' ', vstart)) != base::StringPiece::npos) {
       // Delimited.  Stop at the delimiter, and consume it.
       vend = i;
       *end = vend + 1;
@@ -1378,19 +1452,19 @@ bool TorControl::ParseKV(const std::string& string,
     }
 
     // Check for internal quotes; they are forbidden.
-    if ((i = string.find("\"", vstart)) != std::string::npos)
+    if ((i = string.find('"', vstart)) != base::StringPiece::npos)
       return false;
 
     // Extract the key and value and we're done.
-    *key = string.substr(0, eq);
-    *value = string.substr(vstart, vend - vstart);
+    string.substr(0, eq).CopyToString(key);
+    string.substr(vstart, vend - vstart).CopyToString(value);
     return true;
   }
 
   // Quoted string.  Parse it, and consume trailing spaces.
   if (!ParseQuoted(string.substr(eq + 1), value, end))
     return false;
-  *key = string.substr(0, eq);
+  string.substr(0, eq).CopyToString(key);
   *end += eq + 1;
   while (*end < string.size() && string[*end] == ' ')
     (*end)++;
@@ -1405,7 +1479,7 @@ bool TorControl::ParseKV(const std::string& string,
 //      return false on failure.
 //
 // static
-bool TorControl::ParseQuoted(const std::string& string,
+bool TorControl::ParseQuoted(base::StringPiece string,
                              std::string* value,
                              size_t* end) {
   enum {
@@ -1417,7 +1491,10 @@ bool TorControl::ParseQuoted(const std::string& string,
     OCTAL1,
     OCTAL2,
   } S = START;
-  std::string buf(string.size(), '\0');
+  // Unescape straight into value; the result is never longer than the
+  // input, so this never reallocates.
+  std::string& buf = *value;
+  buf.resize(string.size());
   size_t i, pos = 0;
   unsigned octal;
 
@@ -1528,9 +1605,10 @@ bool TorControl::ParseQuoted(const std::string& string,
     // Handle reject or accept.
     switch (S) {
       case REJECT:
+        buf.clear();
         return false;
       case ACCEPT:
-        *value = buf.substr(0, pos);
+        buf.resize(pos);
         *end = i + 1;
         return true;
       default:
@@ -1539,6 +1617,7 @@ bool TorControl::ParseQuoted(const std::string& string,
   }
 
   // Consumed the whole string without accepting it.  Reject!
+  buf.clear();
   return false;
 }
 
@@ -20,6 +20,7 @@
 #include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
 #include "base/process/process.h"
+#include "base/strings/string_piece.h"
 #include "base/time/time.h"
 
 namespace base {
@@ -100,15 +101,17 @@ class TorControl {
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseQuoted);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseKV);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLine);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadDoneFraming);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReplayBenchmark);
 
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value);
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value,
                       size_t* end);
-  static bool ParseQuoted(const std::string& string,
+  static bool ParseQuoted(base::StringPiece string,
                           std::string* value,
                           size_t* end);
 
@@ -129,7 +132,8 @@ class TorControl {
 
   std::unique_ptr<net::TCPClientSocket> socket_;
 
-  // Write state machine.
+  // Write state machine.  Commands queued while a write is in flight
+  // are coalesced into a single buffer by StartWrite().
   std::queue<std::string> writeq_;
   bool writing_;
   scoped_refptr<net::DrainableIOBuffer> writeiobuf_;
@@ -170,6 +174,7 @@ class TorControl {
   void Authenticated(bool error,
                      const std::string& status,
                      const std::string& reply);
+  void AuthenticationFailed();
 
   void DoCmd(std::string cmd, PerLineCallback perline, CmdCallback callback);
 
@@ -218,9 +223,9 @@ class TorControl {
                       const std::string& initial,
                       const std::map<std::string, std::string>& extra);
   void NotifyTorRawCmd(const std::string& cmd);
-  void NotifyTorRawAsync(const std::string& status, const std::string& line);
-  void NotifyTorRawMid(const std::string& status, const std::string& line);
-  void NotifyTorRawEnd(const std::string& status, const std::string& line);
+  void NotifyTorRawAsync(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawMid(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawEnd(base::StringPiece status, base::StringPiece line);
 
   void StartWrite();
   void DoWrites();
@@ -231,9 +236,10 @@ class TorControl {
   void DoReads();
   void ReadDoneAsync(int rv);
   void ReadDone(int rv);
-  bool ReadLine(const std::string& line);
+  bool ReadLine(base::StringPiece line);
 
   void Error();
+  void Disconnect();
 
   TorControl(const TorControl&) = delete;
   TorControl& operator=(const TorControl&) = delete;
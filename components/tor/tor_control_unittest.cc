@@ -5,11 +5,18 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "base/callback_helpers.h"
+#include "base/logging.h"
 #include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
+#include "net/base/io_buffer.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -28,6 +35,25 @@ class MockTorControlDelegate : public TorControl::Delegate {
   MOCK_METHOD2(OnTorRawMid, void(const std::string&, const std::string&));
   MOCK_METHOD2(OnTorRawEnd, void(const std::string&, const std::string&));
 };
+
+// Feed |input| to |control| as a sequence of socket reads of at most
+// |chunk| octets each, as if it had arrived on the control port.
+void FeedReads(TorControl* control,
+               const std::string& input,
+               size_t chunk,
+               net::GrowableIOBuffer* (*buffer)(TorControl*),
+               void (*read_done)(TorControl*, int)) {
+  size_t pos = 0;
+  while (pos < input.size()) {
+    net::GrowableIOBuffer* buf = buffer(control);
+    ASSERT_TRUE(buf);
+    size_t n = std::min({chunk, input.size() - pos,
+                         static_cast<size_t>(buf->RemainingCapacity())});
+    memcpy(buf->data(), input.data() + pos, n);
+    read_done(control, n);
+    pos += n;
+  }
+}
 }  // namespace
 
 TEST(TorControlTest, ParseQuoted) {
@@ -179,4 +205,84 @@ TEST(TorControlTest, ReadLine) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST(TorControlTest, ReadDoneFraming) {
+  content::BrowserTaskEnvironment task_environment;
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control = TorControl::Create(&delegate);
+
+  std::map<std::string, std::string> circ_extra = {{"PURPOSE", "GENERAL"}};
+  EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::CIRC, "1 BUILT",
+                                   circ_extra)).Times(1);
+  EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::NETWORK_LIVENESS, "UP",
+                                   testing::_)).Times(1);
+  EXPECT_CALL(delegate, OnTorClosed()).Times(0);
+  content::GetIOThreadTaskRunner({})
+    ->PostTask(FROM_HERE,
+               base::BindOnce([](std::unique_ptr<TorControl> control) {
+                control->async_events_[TorControlEvent::CIRC] = 1;
+                control->async_events_[TorControlEvent::NETWORK_LIVENESS] = 1;
+                control->reading_ = true;
+                control->StartRead();
+                // Split every read in the middle of a line, and in
+                // particular between CR and LF.
+                FeedReads(control.get(),
+                          "650-CIRC 1 BUILT\r\n650 PURPOSE=GENERAL\r"
+                          "\n650 NETWORK_LIVENESS UP\r\n",
+                          7,
+                          [](TorControl* c) { return c->readiobuf_.get(); },
+                          [](TorControl* c, int rv) { c->ReadDone(rv); });
+                EXPECT_TRUE(control->reading_);
+                EXPECT_FALSE(control->async_);
+                EXPECT_FALSE(control->read_cr_);
+                // Everything was consumed, so the buffer was rewound.
+                EXPECT_EQ(control->readiobuf_->offset(), 0);
+                EXPECT_EQ(control->read_start_, 0);
+               }, std::move(control)));
+
+  base::RunLoop().RunUntilIdle();
+}
+
+// Replays a synthetic transcript of a busy control port subscribed to
+// CIRC and STREAM events through the read path, and reports timings.
+TEST(TorControlTest, DISABLED_ReplayBenchmark) {
+  content::BrowserTaskEnvironment task_environment;
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control = TorControl::Create(&delegate);
+
+  std::string transcript;
+  for (int i = 0; i < 20000; i++) {
+    transcript += base::StringPrintf(
+        "650 CIRC %d EXTENDED $%040d~relay%d BUILD_FLAGS=NEED_CAPACITY "
+        "PURPOSE=GENERAL TIME_CREATED=2020-10-01T00:00:00.000000\r\n",
+        i, i, i);
+    transcript += base::StringPrintf(
+        "650-STREAM %d SUCCEEDED %d 198.51.100.%d:443\r\n"
+        "650-SOURCE_ADDR=\"127.0.0.1:%d\"\r\n"
+        "650 PURPOSE=USER\r\n",
+        i, i, i % 256, 10000 + i % 50000);
+  }
+
+  content::GetIOThreadTaskRunner({})
+    ->PostTask(FROM_HERE,
+               base::BindOnce([](std::unique_ptr<TorControl> control,
+                                 const std::string& transcript) {
+                control->async_events_[TorControlEvent::CIRC] = 1;
+                control->async_events_[TorControlEvent::STREAM] = 1;
+                control->reading_ = true;
+                control->StartRead();
+                const base::TimeTicks start = base::TimeTicks::Now();
+                FeedReads(control.get(), transcript, 1500,
+                          [](TorControl* c) { return c->readiobuf_.get(); },
+                          [](TorControl* c, int rv) { c->ReadDone(rv); });
+                const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+                EXPECT_TRUE(control->reading_);
+                LOG(INFO) << "Replayed " << transcript.size() << " octets in "
+                          << elapsed.InMicroseconds() << "us";
+               }, std::move(control), std::move(transcript)));
+
+  base::RunLoop().RunUntilIdle();
+}
+
 }  // namespace tor
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/process/kill.h"
 #include "base/task/post_task.h"
 #include "brave/components/tor/service_sandbox_type.h"
@@ -96,6 +97,8 @@ void TorLauncherFactory::LaunchTorProcess(const tor::mojom::TorConfig& config) {
   DCHECK(!config.tor_data_path.empty());
   DCHECK(!config.tor_watch_path.empty());
   config_ = config;
+  launch_requested_time_ = base::TimeTicks::Now();
+  launched_time_ = base::TimeTicks();
 
   // Tor launcher could be null if we created Tor process and killed it
   // through KillTorProcess function before. So we need to initialize
@@ -201,6 +204,7 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
     // We have to wait for circuit established
     is_connected_ = false;
     tor_pid_ = pid;
+    launched_time_ = base::TimeTicks::Now();
   } else {
     LOG(ERROR) << "Tor Launching Failed(" << pid << ")";
   }
@@ -212,6 +216,18 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
 void TorLauncherFactory::OnTorControlReady() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   VLOG(2) << "TOR CONTROL: Ready!";
+  // Only the first ready per launch counts; later ones are reconnects.
+  if (!launch_requested_time_.is_null()) {
+    const base::TimeTicks now = base::TimeTicks::Now();
+    UMA_HISTOGRAM_MEDIUM_TIMES("Brave.Tor.LaunchToControlReadyTime",
+                               now - launch_requested_time_);
+    if (!launched_time_.is_null()) {
+      UMA_HISTOGRAM_MEDIUM_TIMES("Brave.Tor.ProcessStartToControlReadyTime",
+                                 now - launched_time_);
+    }
+    launch_requested_time_ = base::TimeTicks();
+    launched_time_ = base::TimeTicks();
+  }
   control_->GetVersion(base::BindOnce(&TorLauncherFactory::GotVersion,
                                       weak_ptr_factory_.GetWeakPtr()));
   control_->GetSOCKSListeners(base::BindOnce(
@@ -282,6 +298,8 @@ void TorLauncherFactory::KillOldTorProcess(base::ProcessId id) {
 }
 
 void TorLauncherFactory::RelaunchTor() {
+  launch_requested_time_ = base::TimeTicks::Now();
+  launched_time_ = base::TimeTicks();
   Init();
   control_->PreStartCheck(
       config_.tor_watch_path,
@@ -17,6 +17,7 @@
 #include "base/memory/singleton.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
+#include "base/time/time.h"
 #include "brave/components/services/tor/public/interfaces/tor.mojom.h"
 #include "brave/components/tor/tor_control.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -90,6 +91,12 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   int64_t tor_pid_;
 
+  // When the current launch was requested and when the tor process came
+  // up, for measuring how long it takes the control channel to become
+  // ready.  Null once the first OnTorControlReady for the launch is seen.
+  base::TimeTicks launch_requested_time_;
+  base::TimeTicks launched_time_;
+
   tor::mojom::TorConfig config_;
 
   base::ObserverList<TorLauncherObserver> observers_;
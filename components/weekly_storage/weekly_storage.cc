@@ -5,9 +5,10 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
+#include <algorithm>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
@@ -15,8 +16,12 @@
 #include "components/prefs/scoped_user_pref_update.h"
 
 namespace {
-constexpr size_t kDaysInWeek = 7;
-}
+// How long updates are batched in memory before being written to prefs.
+constexpr base::TimeDelta kSaveDelay = base::TimeDelta::FromSeconds(10);
+}  // namespace
+
+// static
+constexpr size_t WeeklyStorage::kDaysInWeek;
 
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
@@ -37,87 +42,97 @@ WeeklyStorage::WeeklyStorage(PrefService* prefs,
   Load();
 }
 
-WeeklyStorage::~WeeklyStorage() = default;
+WeeklyStorage::~WeeklyStorage() {
+  // Most callers create a short-lived instance per update, so make sure
+  // nothing batched is lost.
+  Flush();
+}
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
   FilterToWeek();
-  daily_values_.front().value += delta;
-  Save();
+  Today().value += delta;
+  ScheduleSave();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
   FilterToWeek();
-  DailyValue& today = daily_values_.front();
+  DailyValue& today = Today();
   if (today.value < value) {
     today.value = value;
+    ScheduleSave();
   }
-  Save();
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  uint64_t sum = 0;
+  for (size_t i = 0; i < size_; i++) {
+    const DailyValue& u = GetDay(i);
+    // Check only last continious days.
+    if (u.day > n_days_ago) {
+      sum += u.value;
+    }
+  }
+  return sum;
 }
 
 uint64_t WeeklyStorage::GetHighestValueInWeek() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  std::list<DailyValue> last_weeks_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   last_weeks_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  last_weeks_daily_values.resize(
-      std::distance(last_weeks_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(last_weeks_daily_values.begin(),
-                                     last_weeks_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == last_weeks_daily_values.end()) {
-    return 0;
+  uint64_t highest = 0;
+  for (size_t i = 0; i < size_; i++) {
+    const DailyValue& u = GetDay(i);
+    if (u.day > n_days_ago) {
+      highest = std::max(highest, u.value);
+    }
   }
-  return highest_it->value;
+  return highest;
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
   // TODO(iefremov): This is not true 100% (if the browser was launched once
   // per week just after installation, for example).
-  return daily_values_.size() == kDaysInWeek;
+  return size_ == kDaysInWeek;
+}
+
+void WeeklyStorage::Flush() {
+  if (dirty_) {
+    Save();
+  }
+}
+
+const WeeklyStorage::DailyValue& WeeklyStorage::GetDay(size_t i) const {
+  DCHECK_LT(i, size_);
+  return daily_values_[(head_ + i) % kDaysInWeek];
+}
+
+WeeklyStorage::DailyValue& WeeklyStorage::Today() {
+  DCHECK_GT(size_, 0u);
+  return daily_values_[head_];
 }
 
 void WeeklyStorage::FilterToWeek() {
   base::Time now_midnight = clock_->Now().LocalMidnight();
   base::Time last_saved_midnight;
 
-  if (!daily_values_.empty()) {
-    last_saved_midnight = daily_values_.front().day;
+  if (size_ > 0) {
+    last_saved_midnight = Today().day;
   }
 
   if (now_midnight - last_saved_midnight > base::TimeDelta()) {
     // Day changed. Since we consider only small incoming intervals, lets just
-    // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, 0});
-    if (daily_values_.size() > kDaysInWeek) {
-      daily_values_.pop_back();
-    }
+    // save it with a new timestamp. The oldest day, if any, is overwritten.
+    head_ = (head_ + kDaysInWeek - 1) % kDaysInWeek;
+    daily_values_[head_] = {now_midnight, 0};
+    size_ = std::min(size_ + 1, kDaysInWeek);
   }
 }
 
 void WeeklyStorage::Load() {
-  DCHECK(daily_values_.empty());
+  DCHECK_EQ(size_, 0u);
   const base::ListValue* list = prefs_->GetList(pref_name_);
   if (!list) {
     return;
@@ -128,23 +143,35 @@ void WeeklyStorage::Load() {
     if (!day || !value || !day->is_double() || !value->is_double()) {
       continue;
     }
-    if (daily_values_.size() == kDaysInWeek) {
+    if (size_ == kDaysInWeek) {
       break;
     }
-    daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
-                             static_cast<uint64_t>(value->GetDouble())});
+    // The pref list is stored newest first, same as the ring.
+    daily_values_[size_++] = {base::Time::FromDoubleT(day->GetDouble()),
+                              static_cast<uint64_t>(value->GetDouble())};
+  }
+}
+
+void WeeklyStorage::ScheduleSave() {
+  dirty_ = true;
+  if (!save_timer_.IsRunning()) {
+    save_timer_.Start(
+        FROM_HERE, kSaveDelay,
+        base::BindOnce(&WeeklyStorage::Save, base::Unretained(this)));
   }
 }
 
 void WeeklyStorage::Save() {
-  DCHECK(!daily_values_.empty());
-  DCHECK_LE(daily_values_.size(), kDaysInWeek);
+  DCHECK_GT(size_, 0u);
+  DCHECK_LE(size_, kDaysInWeek);
+  save_timer_.Stop();
+  dirty_ = false;
 
   ListPrefUpdate update(prefs_, pref_name_);
   base::ListValue* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
   list->Clear();
-  for (const auto& u : daily_values_) {
+  for (size_t i = 0; i < size_; i++) {
+    const DailyValue& u = GetDay(i);
     base::DictionaryValue value;
     value.SetKey("day", base::Value(u.day.ToDoubleT()));
     value.SetDoubleKey("value", u.value);
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
+#include <array>
 #include <memory>
 
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
@@ -20,6 +21,9 @@ class PrefService;
 // Mostly used by various P3A recorders - allows to track a sum of some
 // values added from time to time via |AddDelta| over a last week.
 // Requires |pref_name| to be already registered.
+// Updates are kept in memory and written to prefs after a short delay (or on
+// destruction), so it is cheap to call |AddDelta| for every event. Must be
+// used on a sequence. Long-lived owners should call |Flush| at shutdown.
 // Feel free to improve and refactor it - templatize a stored value type,
 // change weekly interval or make a keyed service from it.
 class WeeklyStorage {
@@ -40,21 +44,35 @@ class WeeklyStorage {
   uint64_t GetWeeklySum() const;
   uint64_t GetHighestValueInWeek() const;
   bool IsOneWeekPassed() const;
+  // Writes any batched updates to prefs right away.
+  void Flush();
 
  private:
+  static constexpr size_t kDaysInWeek = 7;
+
   struct DailyValue {
     base::Time day;
     uint64_t value = 0ull;
   };
+  // |i| == 0 is the most recently recorded day.
+  const DailyValue& GetDay(size_t i) const;
+  DailyValue& Today();
   void FilterToWeek();
   void Load();
+  void ScheduleSave();
   void Save();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Ring buffer of the last |kDaysInWeek| recorded days, newest at |head_|.
+  std::array<DailyValue, kDaysInWeek> daily_values_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+
+  bool dirty_ = false;
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
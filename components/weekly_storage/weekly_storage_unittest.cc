@@ -9,15 +9,17 @@
 #include <utility>
 
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+constexpr char kPrefName[] = "brave.weekly_test";
+
 class WeeklyStorageTest : public ::testing::Test {
  public:
   WeeklyStorageTest() : clock_(new base::SimpleTestClock) {
-    constexpr char kPrefName[] = "brave.weekly_test";
     pref_service_.registry()->RegisterListPref(kPrefName);
 
     state_ = std::make_unique<WeeklyStorage>(
@@ -26,6 +28,8 @@ class WeeklyStorageTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<WeeklyStorage> state_;
@@ -138,3 +142,43 @@ TEST_F(WeeklyStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetWeeklySum(), high_value + low_value);
 }
+
+TEST_F(WeeklyStorageTest, BatchesPrefWrites) {
+  state_->AddDelta(1);
+  state_->AddDelta(2);
+  // Nothing is written until the save delay elapses.
+  EXPECT_TRUE(pref_service_.GetList(kPrefName)->GetList().empty());
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 1u);
+
+  // A fresh instance sees the saved value.
+  auto clock = std::make_unique<base::SimpleTestClock>();
+  clock->SetNow(clock_->Now());
+  WeeklyStorage reloaded(&pref_service_, kPrefName, std::move(clock));
+  EXPECT_EQ(reloaded.GetWeeklySum(), 3ULL);
+}
+
+TEST_F(WeeklyStorageTest, SavesOnDestruction) {
+  uint64_t saving = 10000;
+  for (int day = 0; day < 10; day++) {
+    clock_->Advance(base::TimeDelta::FromDays(1));
+    state_->AddDelta(saving);
+  }
+  // |clock_| is owned by |state_|.
+  const base::Time now = clock_->Now();
+  state_.reset();
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 7u);
+
+  auto clock = std::make_unique<base::SimpleTestClock>();
+  clock->SetNow(now);
+  WeeklyStorage reloaded(&pref_service_, kPrefName, std::move(clock));
+  EXPECT_TRUE(reloaded.IsOneWeekPassed());
+  EXPECT_EQ(reloaded.GetWeeklySum(), 7 * saving);
+}
+
+TEST_F(WeeklyStorageTest, FlushWritesImmediately) {
+  state_->AddDelta(5);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName)->GetList().empty());
+  state_->Flush();
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 1u);
+}
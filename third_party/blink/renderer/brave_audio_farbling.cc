@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+
+#include <algorithm>
+
+namespace {
+
+const uint64_t zero = 0;
+
+// Same LFSR as the rest of the farbling code in execution_context.cc.
+inline uint64_t lfsr_next(uint64_t v) {
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+const double maxUInt64AsDouble = UINT64_MAX;
+
+// Number of PRNG values generated before they are converted in one pass.
+const size_t kPseudoRandomBlockSize = 256;
+
+// return pseudo-random float between 0 and 0.1
+inline float PseudoRandomSample(uint64_t v) {
+  return (v / maxUInt64AsDouble) / 10;
+}
+
+}  // namespace
+
+namespace brave {
+
+void FarbleAudioSamplesBalanced(double fudge_factor,
+                                float* samples,
+                                size_t size) {
+  for (size_t i = 0; i < size; ++i)
+    samples[i] = samples[i] * fudge_factor;
+}
+
+void FarbleAudioSamplesMaximum(uint64_t seed, float* samples, size_t size) {
+  // The LFSR is inherently serial, so generate a block of values first and
+  // convert them in a separate loop the compiler can vectorize.
+  uint64_t v = seed;
+  uint64_t values[kPseudoRandomBlockSize];
+  for (size_t offset = 0; offset < size; offset += kPseudoRandomBlockSize) {
+    const size_t count = std::min(kPseudoRandomBlockSize, size - offset);
+    for (size_t i = 0; i < count; ++i) {
+      v = lfsr_next(v);
+      values[i] = v;
+    }
+    float* const block = samples + offset;
+    for (size_t i = 0; i < count; ++i)
+      block[i] = PseudoRandomSample(values[i]);
+  }
+}
+
+float NextMaximumFarblingAudioSample(uint64_t* state) {
+  *state = lfsr_next(*state);
+  return PseudoRandomSample(*state);
+}
+
+}  // namespace brave
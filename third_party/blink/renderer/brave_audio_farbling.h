@@ -0,0 +1,30 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Multiplies each of the |size| samples by |fudge_factor| (balanced
+// farbling).
+void FarbleAudioSamplesBalanced(double fudge_factor,
+                                float* samples,
+                                size_t size);
+
+// Replaces each of the |size| samples with a pseudo-random value between 0 and
+// 0.1 generated from |seed| (maximum farbling).
+void FarbleAudioSamplesMaximum(uint64_t seed, float* samples, size_t size);
+
+// Advances |state| and returns the matching maximum farbling sample. Starting
+// from |seed| this yields the same values as FarbleAudioSamplesMaximum().
+float NextMaximumFarblingAudioSample(uint64_t* state);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
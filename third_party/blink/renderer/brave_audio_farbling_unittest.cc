@@ -0,0 +1,96 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveAudioFarblingTest.*
+
+namespace brave {
+
+namespace {
+
+const uint64_t kSeed = 0x0123456789abcdefULL;
+const double kFudgeFactor = 0.99 + 0.0042;
+
+// Sizes around the block size used for maximum farbling.
+const size_t kSizes[] = {0, 1, 255, 256, 257, 1000, 4096};
+
+// The per-sample callbacks used before channels were farbled in blocks.
+const uint64_t zero = 0;
+
+uint64_t lfsr_next(uint64_t v) {
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+float ConstantMultiplier(double fudge_factor, float value, size_t index) {
+  return value * fudge_factor;
+}
+
+float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
+  static uint64_t v;
+  const double maxUInt64AsDouble = UINT64_MAX;
+  if (index == 0) {
+    v = seed;
+  }
+  v = lfsr_next(v);
+  return (v / maxUInt64AsDouble) / 10;
+}
+
+std::vector<float> MakeSamples(size_t size) {
+  std::vector<float> samples(size);
+  for (size_t i = 0; i < size; ++i)
+    samples[i] = static_cast<float>(i % 200) / 100 - 1;
+  return samples;
+}
+
+}  // namespace
+
+TEST(BraveAudioFarblingTest, BalancedMatchesPerSampleFormula) {
+  for (size_t size : kSizes) {
+    std::vector<float> samples = MakeSamples(size);
+    std::vector<float> expected = samples;
+    for (size_t i = 0; i < size; ++i)
+      expected[i] = ConstantMultiplier(kFudgeFactor, expected[i], i);
+
+    FarbleAudioSamplesBalanced(kFudgeFactor, samples.data(), samples.size());
+    EXPECT_EQ(expected, samples) << "size " << size;
+  }
+}
+
+TEST(BraveAudioFarblingTest, MaximumMatchesPerSampleFormula) {
+  for (size_t size : kSizes) {
+    std::vector<float> samples = MakeSamples(size);
+    std::vector<float> expected = samples;
+    for (size_t i = 0; i < size; ++i)
+      expected[i] = PseudoRandomSequence(kSeed, expected[i], i);
+
+    FarbleAudioSamplesMaximum(kSeed, samples.data(), samples.size());
+    EXPECT_EQ(expected, samples) << "size " << size;
+
+    uint64_t state = kSeed;
+    std::vector<float> per_sample(size);
+    for (size_t i = 0; i < size; ++i)
+      per_sample[i] = NextMaximumFarblingAudioSample(&state);
+    EXPECT_EQ(expected, per_sample) << "size " << size;
+  }
+}
+
+TEST(BraveAudioFarblingTest, MaximumRestartsFromSeed) {
+  std::vector<float> first = MakeSamples(300);
+  std::vector<float> second = MakeSamples(300);
+  FarbleAudioSamplesMaximum(kSeed, first.data(), first.size());
+  FarbleAudioSamplesMaximum(kSeed, second.data(), second.size());
+  EXPECT_EQ(first, second);
+  for (float sample : first) {
+    EXPECT_GE(sample, 0);
+    EXPECT_LE(sample, 0.1f);
+  }
+}
+
+}  // namespace brave
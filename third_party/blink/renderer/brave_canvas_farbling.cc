@@ -0,0 +1,100 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace brave {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+// Independent accumulators, so consecutive words don't form one long
+// dependency chain and the inner loop can be vectorized.
+constexpr size_t kLanes = 4;
+
+constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+constexpr uint64_t kLaneSeeds[kLanes] = {
+    0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL, 0xa4093822299f31d0ULL,
+    0x082efa98ec4e6c89ULL};
+
+inline uint64_t Mix(uint64_t lane, uint64_t word) {
+  lane = (lane ^ word) * kMultiplier;
+  return (lane << 29) | (lane >> 35);
+}
+
+// Final avalanche from MurmurHash3.
+inline uint64_t Finalize(uint64_t v) {
+  v ^= v >> 33;
+  v *= 0xff51afd7ed558ccdULL;
+  v ^= v >> 33;
+  v *= 0xc4ceb9fe1a85ec53ULL;
+  v ^= v >> 33;
+  return v;
+}
+
+uint64_t HashTile(const uint8_t* first_row,
+                  size_t row_stride,
+                  size_t row_bytes,
+                  size_t rows) {
+  uint64_t lanes[kLanes];
+  std::copy(std::begin(kLaneSeeds), std::end(kLaneSeeds), lanes);
+
+  constexpr size_t kBlockBytes = kLanes * sizeof(uint64_t);
+  for (size_t y = 0; y < rows; ++y) {
+    const uint8_t* row = first_row + y * row_stride;
+    size_t x = 0;
+    for (; x + kBlockBytes <= row_bytes; x += kBlockBytes) {
+      uint64_t words[kLanes];
+      memcpy(words, row + x, kBlockBytes);
+      for (size_t i = 0; i < kLanes; ++i)
+        lanes[i] = Mix(lanes[i], words[i]);
+    }
+    // Rows of partial tiles end with whole pixels that don't fill a block.
+    for (; x < row_bytes; x += kBytesPerPixel) {
+      uint32_t pixel;
+      memcpy(&pixel, row + x, kBytesPerPixel);
+      lanes[0] = Mix(lanes[0], pixel);
+    }
+  }
+
+  uint64_t digest = (static_cast<uint64_t>(rows) << 32) ^ row_bytes;
+  for (size_t i = 0; i < kLanes; ++i)
+    digest = Mix(digest, lanes[i]);
+  return Finalize(digest);
+}
+
+size_t TilesFor(size_t pixels) {
+  return (pixels + kCanvasFarblingTileSize - 1) / kCanvasFarblingTileSize;
+}
+
+}  // namespace
+
+size_t GetCanvasTileCount(size_t width, size_t height) {
+  return TilesFor(width) * TilesFor(height);
+}
+
+void HashCanvasTiles(const uint8_t* pixels,
+                     size_t width,
+                     size_t height,
+                     uint64_t* digests) {
+  const size_t row_stride = width * kBytesPerPixel;
+  for (size_t tile_y = 0; tile_y < height; tile_y += kCanvasFarblingTileSize) {
+    const size_t rows = std::min(kCanvasFarblingTileSize, height - tile_y);
+    for (size_t tile_x = 0; tile_x < width; tile_x += kCanvasFarblingTileSize) {
+      const size_t columns = std::min(kCanvasFarblingTileSize, width - tile_x);
+      *digests++ = HashTile(
+          pixels + tile_y * row_stride + tile_x * kBytesPerPixel, row_stride,
+          columns * kBytesPerPixel, rows);
+    }
+  }
+}
+
+}  // namespace brave
@@ -0,0 +1,31 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Canvas contents are digested in square tiles of this many pixels per side.
+constexpr size_t kCanvasFarblingTileSize = 64;
+
+// Returns the number of tiles covering a |width| x |height| canvas.
+size_t GetCanvasTileCount(size_t width, size_t height);
+
+// Writes one digest per tile of a tightly packed RGBA buffer of |width| x
+// |height| pixels to |digests|, which must hold GetCanvasTileCount() values.
+// Tiles are ordered row by row. The digest is fast but not cryptographic; it
+// is only meant to be keyed afterwards to seed canvas farbling.
+void HashCanvasTiles(const uint8_t* pixels,
+                     size_t width,
+                     size_t height,
+                     uint64_t* digests);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
@@ -0,0 +1,84 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
+
+#include <vector>
+
+#include "base/logging.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+std::vector<uint8_t> MakeCanvas(size_t width, size_t height) {
+  std::vector<uint8_t> pixels(width * height * 4);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<uint8_t>(i * 31 + (i >> 8));
+  return pixels;
+}
+
+std::vector<uint64_t> HashTiles(const std::vector<uint8_t>& pixels,
+                                size_t width,
+                                size_t height) {
+  std::vector<uint64_t> digests(GetCanvasTileCount(width, height));
+  HashCanvasTiles(pixels.data(), width, height, digests.data());
+  return digests;
+}
+
+}  // namespace
+
+TEST(BraveCanvasFarblingTest, TileCount) {
+  EXPECT_EQ(1u, GetCanvasTileCount(1, 1));
+  EXPECT_EQ(1u, GetCanvasTileCount(64, 64));
+  EXPECT_EQ(2u, GetCanvasTileCount(65, 64));
+  EXPECT_EQ(4u, GetCanvasTileCount(65, 65));
+  EXPECT_EQ(64u * 64u, GetCanvasTileCount(4096, 4096));
+}
+
+TEST(BraveCanvasFarblingTest, DigestsAreDeterministic) {
+  const std::vector<uint8_t> pixels = MakeCanvas(300, 150);
+  EXPECT_EQ(HashTiles(pixels, 300, 150), HashTiles(pixels, 300, 150));
+}
+
+TEST(BraveCanvasFarblingTest, ChangesOnlyAffectTheirTile) {
+  constexpr size_t kWidth = 130;
+  constexpr size_t kHeight = 70;
+  std::vector<uint8_t> pixels = MakeCanvas(kWidth, kHeight);
+  const std::vector<uint64_t> before = HashTiles(pixels, kWidth, kHeight);
+  ASSERT_EQ(6u, before.size());
+
+  // Flip one bit of the last pixel, which lives in the partial bottom-right
+  // tile.
+  pixels.back() ^= 1;
+  const std::vector<uint64_t> after = HashTiles(pixels, kWidth, kHeight);
+  for (size_t i = 0; i + 1 < before.size(); ++i)
+    EXPECT_EQ(before[i], after[i]) << "tile " << i;
+  EXPECT_NE(before.back(), after.back());
+}
+
+TEST(BraveCanvasFarblingTest, DimensionsAffectDigest) {
+  // The same bytes laid out differently must not collide.
+  const std::vector<uint8_t> pixels(32 * 2 * 4, 0);
+  EXPECT_NE(HashTiles(pixels, 32, 2), HashTiles(pixels, 2, 32));
+}
+
+TEST(BraveCanvasFarblingTest, DISABLED_HashBenchmark) {
+  for (size_t size = 256; size <= 4096; size *= 2) {
+    const std::vector<uint8_t> pixels = MakeCanvas(size, size);
+    std::vector<uint64_t> digests(GetCanvasTileCount(size, size));
+    constexpr int kIterations = 10;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i)
+      HashCanvasTiles(pixels.data(), size, size, digests.data());
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    LOG(INFO) << size << "x" << size << " canvas: "
+              << elapsed.InMicroseconds() / kIterations << "us per hash";
+  }
+}
+
+}  // namespace brave